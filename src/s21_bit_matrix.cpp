@@ -0,0 +1,284 @@
+#include "s21_bit_matrix.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define S21_X86_KERNELS
+#endif
+
+namespace {
+
+constexpr int kWordBits = 64;
+// Минимум строк на поток в произведениях
+constexpr int kParallelRows = 16;
+
+// Кол-во единиц в a & b для n слов
+using AndCountKernel = long long (*)(const uint64_t *a, const uint64_t *b,
+                                     size_t n);
+
+long long AndCountPortable(const uint64_t *a, const uint64_t *b, size_t n) {
+  long long count = 0;
+  for (size_t k = 0; k < n; k++) {
+    count += __builtin_popcountll(a[k] & b[k]);
+  }
+  return count;
+}
+
+#ifdef S21_X86_KERNELS
+// Без -mpopcnt встроенная функция вызывает программный подсчет; здесь она
+// становится одной инструкцией popcnt
+__attribute__((target("popcnt"))) long long AndCountPopcnt(const uint64_t *a,
+                                                           const uint64_t *b,
+                                                           size_t n) {
+  long long count = 0;
+  for (size_t k = 0; k < n; k++) {
+    count += __builtin_popcountll(a[k] & b[k]);
+  }
+  return count;
+}
+#endif
+
+AndCountKernel SelectAndCount() {
+#ifdef S21_X86_KERNELS
+  if (__builtin_cpu_supports("popcnt")) {
+    return AndCountPopcnt;
+  }
+#endif
+  return AndCountPortable;
+}
+
+long long AndCount(const uint64_t *a, const uint64_t *b, size_t n) {
+  static const AndCountKernel kernel = SelectAndCount();
+  return kernel(a, b, n);
+}
+
+// Транспонирует блок 64 x 64, где бит c слова r - элемент (r, c): на шаге
+// j меняются местами четверти размера j, всего log2(64) = 6 шагов
+void Transpose64(uint64_t block[kWordBits]) {
+  uint64_t mask = 0x00000000FFFFFFFFull;
+  for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+    for (int k = 0; k < kWordBits; k = ((k | j) + 1) & ~j) {
+      uint64_t swap = ((block[k] >> j) ^ block[k | j]) & mask;
+      block[k] ^= swap << j;
+      block[k | j] ^= swap;
+    }
+  }
+}
+
+}  // namespace
+
+S21BitMatrix::S21BitMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), words_((cols + kWordBits - 1) / kWordBits) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+  bits_.assign(static_cast<size_t>(rows_) * words_, 0);
+}
+
+S21BitMatrix::S21BitMatrix(const S21Matrix &matrix)
+    : S21BitMatrix(matrix.GetRows(), matrix.GetCols()) {
+  for (int i = 0; i < rows_; i++) {
+    const double *in = &matrix(i, 0);
+    uint64_t *out = Row(i);
+    for (int j = 0; j < cols_; j++) {
+      out[j / kWordBits] |= static_cast<uint64_t>(in[j] != 0.0)
+                            << (j % kWordBits);
+    }
+  }
+}
+
+int S21BitMatrix::GetRows() const { return rows_; }
+
+int S21BitMatrix::GetCols() const { return cols_; }
+
+uint64_t *S21BitMatrix::Row(int i) {
+  return bits_.data() + static_cast<size_t>(i) * words_;
+}
+
+const uint64_t *S21BitMatrix::Row(int i) const {
+  return bits_.data() + static_cast<size_t>(i) * words_;
+}
+
+bool S21BitMatrix::Get(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix index is out of range.");
+  }
+  return (Row(i)[j / kWordBits] >> (j % kWordBits)) & 1;
+}
+
+void S21BitMatrix::Set(int i, int j, bool value) {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix index is out of range.");
+  }
+  uint64_t bit = uint64_t{1} << (j % kWordBits);
+  uint64_t &word = Row(i)[j / kWordBits];
+  word = value ? word | bit : word & ~bit;
+}
+
+long long S21BitMatrix::Count() const {
+  return AndCount(bits_.data(), bits_.data(), bits_.size());
+}
+
+S21Matrix S21BitMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const uint64_t *in = Row(i);
+    double *out = &result(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      out[j] = (in[j / kWordBits] >> (j % kWordBits)) & 1;
+    }
+  }
+  return result;
+}
+
+void S21BitMatrix::CheckSameSize(const S21BitMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for element-wise operation.");
+  }
+}
+
+void S21BitMatrix::ClearPadding() {
+  int tail = cols_ % kWordBits;
+  if (tail == 0) {
+    return;
+  }
+  uint64_t mask = (uint64_t{1} << tail) - 1;
+  for (int i = 0; i < rows_; i++) {
+    Row(i)[words_ - 1] &= mask;
+  }
+}
+
+S21BitMatrix &S21BitMatrix::operator&=(const S21BitMatrix &other) {
+  CheckSameSize(other);
+  for (size_t k = 0; k < bits_.size(); k++) {
+    bits_[k] &= other.bits_[k];
+  }
+  return *this;
+}
+
+S21BitMatrix &S21BitMatrix::operator|=(const S21BitMatrix &other) {
+  CheckSameSize(other);
+  for (size_t k = 0; k < bits_.size(); k++) {
+    bits_[k] |= other.bits_[k];
+  }
+  return *this;
+}
+
+S21BitMatrix &S21BitMatrix::operator^=(const S21BitMatrix &other) {
+  CheckSameSize(other);
+  for (size_t k = 0; k < bits_.size(); k++) {
+    bits_[k] ^= other.bits_[k];
+  }
+  return *this;
+}
+
+S21BitMatrix S21BitMatrix::operator&(const S21BitMatrix &other) const {
+  S21BitMatrix result(*this);
+  result &= other;
+  return result;
+}
+
+S21BitMatrix S21BitMatrix::operator|(const S21BitMatrix &other) const {
+  S21BitMatrix result(*this);
+  result |= other;
+  return result;
+}
+
+S21BitMatrix S21BitMatrix::operator^(const S21BitMatrix &other) const {
+  S21BitMatrix result(*this);
+  result ^= other;
+  return result;
+}
+
+S21BitMatrix S21BitMatrix::operator~() const {
+  S21BitMatrix result(*this);
+  for (uint64_t &word : result.bits_) {
+    word = ~word;
+  }
+  // Инверсия зажгла биты за последним столбцом
+  result.ClearPadding();
+  return result;
+}
+
+bool S21BitMatrix::operator==(const S21BitMatrix &other) const {
+  return rows_ == other.rows_ && cols_ == other.cols_ && bits_ == other.bits_;
+}
+
+S21BitMatrix S21BitMatrix::Transpose() const {
+  S21BitMatrix result(cols_, rows_);
+  uint64_t block[kWordBits];
+  // Блок (bi, bj) - строки 64 * bi.., слово bj; после транспонирования
+  // он становится словом bi строк 64 * bj..
+  for (int bi = 0; bi < result.words_; bi++) {
+    int row_begin = bi * kWordBits;
+    int row_count = std::min(kWordBits, rows_ - row_begin);
+    for (int bj = 0; bj < words_; bj++) {
+      for (int r = 0; r < kWordBits; r++) {
+        block[r] = r < row_count ? Row(row_begin + r)[bj] : 0;
+      }
+      Transpose64(block);
+      int col_begin = bj * kWordBits;
+      int col_count = std::min(kWordBits, cols_ - col_begin);
+      for (int c = 0; c < col_count; c++) {
+        result.Row(col_begin + c)[bi] = block[c];
+      }
+    }
+  }
+  return result;
+}
+
+S21BitMatrix S21BitMatrix::Mul(const S21BitMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  S21BitMatrix result(rows_, other.cols_);
+  int words = other.words_;
+  S21ParallelFor(0, rows_, kParallelRows, [&](int, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      const uint64_t *a_row = Row(i);
+      uint64_t *out =
+          result.bits_.data() + static_cast<size_t>(i) * result.words_;
+      for (int w = 0; w < words_; w++) {
+        // Перебор только единичных битов слова
+        for (uint64_t word = a_row[w]; word != 0; word &= word - 1) {
+          int k = w * kWordBits + __builtin_ctzll(word);
+          const uint64_t *b_row = other.Row(k);
+          for (int j = 0; j < words; j++) {
+            out[j] |= b_row[j];
+          }
+        }
+      }
+    }
+  });
+  return result;
+}
+
+S21Matrix S21BitMatrix::CountMul(const S21BitMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  // Столбцы other становятся строками, и оба множителя читаются подряд
+  S21BitMatrix columns = other.Transpose();
+  S21Matrix result(rows_, other.cols_);
+  std::vector<double *> out_rows(rows_);
+  for (int i = 0; i < rows_; i++) {
+    out_rows[i] = &result(i, 0);
+  }
+  S21ParallelFor(0, rows_, kParallelRows, [&](int, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      const uint64_t *a_row = Row(i);
+      for (int j = 0; j < other.cols_; j++) {
+        out_rows[i][j] = static_cast<double>(
+            AndCount(a_row, columns.Row(j), static_cast<size_t>(words_)));
+      }
+    }
+  });
+  return result;
+}
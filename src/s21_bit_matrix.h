@@ -0,0 +1,71 @@
+#ifndef SRC_S21_BIT_MATRIX_H_
+#define SRC_S21_BIT_MATRIX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Булева матрица по биту на элемент: строка - массив 64-битных
+/// слов, столбец j - бит j % 64 слова j / 64. Биты за последним столбцом
+/// всегда нулевые, поэтому операции и подсчет работают целыми словами
+class S21BitMatrix {
+ public:
+  /// @brief Нулевая матрица
+  /// @throw std::invalid_argument rows или cols <= 0
+  S21BitMatrix(int rows, int cols);
+
+  /// @brief Ненулевые элементы становятся единицами
+  explicit S21BitMatrix(const S21Matrix &matrix);
+
+  int GetRows() const;
+  int GetCols() const;
+
+  /// @throw std::out_of_range индекс вне матрицы
+  bool Get(int i, int j) const;
+  void Set(int i, int j, bool value);
+
+  /// @brief Кол-во единиц
+  long long Count() const;
+
+  /// @brief Матрица из 0.0 и 1.0
+  S21Matrix ToMatrix() const;
+
+  /// @brief Поэлементные операции, по слову за раз
+  /// @throw std::invalid_argument размеры не совпадают
+  S21BitMatrix operator&(const S21BitMatrix &other) const;
+  S21BitMatrix operator|(const S21BitMatrix &other) const;
+  S21BitMatrix operator^(const S21BitMatrix &other) const;
+  S21BitMatrix operator~() const;
+  S21BitMatrix &operator&=(const S21BitMatrix &other);
+  S21BitMatrix &operator|=(const S21BitMatrix &other);
+  S21BitMatrix &operator^=(const S21BitMatrix &other);
+  bool operator==(const S21BitMatrix &other) const;
+
+  /// @brief Транспонирование блоками 64 x 64: каждый блок переставляется
+  /// за 6 шагов обменов половин внутри слов
+  S21BitMatrix Transpose() const;
+
+  /// @brief Булево произведение: строка i результата - OR строк other,
+  /// отмеченных единицами в строке i. Строки делятся между потоками
+  /// @throw std::invalid_argument cols != other.rows
+  S21BitMatrix Mul(const S21BitMatrix &other) const;
+
+  /// @brief Счетное произведение: c(i, j) = кол-во k с a(i, k) и b(k, j),
+  /// то есть popcount(строка i & столбец j)
+  /// @throw std::invalid_argument cols != other.rows
+  S21Matrix CountMul(const S21BitMatrix &other) const;
+
+ private:
+  uint64_t *Row(int i);
+  const uint64_t *Row(int i) const;
+  void CheckSameSize(const S21BitMatrix &other) const;
+  void ClearPadding();
+
+  int rows_;
+  int cols_;
+  int words_;  // слов в строке
+  std::vector<uint64_t> bits_;
+};
+
+#endif  // SRC_S21_BIT_MATRIX_H_
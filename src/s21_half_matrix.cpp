@@ -0,0 +1,311 @@
+#include "s21_half_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define S21_X86_KERNELS
+#endif
+
+namespace {
+
+// Размер блока поэлементных операций: буферы float остаются в L1
+constexpr size_t kChunk = 256;
+// Ширина раскодированной панели правого множителя
+constexpr int kPanelCols = 128;
+// Минимум строк на поток
+constexpr int kParallelRows = 8;
+
+uint32_t FloatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float BitsFloat(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// bf16 - старшие 16 бит float; округление к четному прибавлением
+// 0x7FFF + младший бит результата
+uint16_t FloatToBFloat16(float value) {
+  uint32_t bits = FloatBits(value);
+  if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+    return static_cast<uint16_t>((bits >> 16) | 0x40);  // тихий NaN
+  }
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+float BFloat16ToFloat(uint16_t value) {
+  return BitsFloat(static_cast<uint32_t>(value) << 16);
+}
+
+uint16_t FloatToHalf(float value) {
+  uint32_t bits = FloatBits(value);
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  uint32_t magnitude = bits & 0x7FFFFFFF;
+  if (magnitude >= 0x7F800000) {
+    // Бесконечность или NaN
+    return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0);
+  }
+  if (magnitude >= 0x477FF000) {
+    // От 65520 округляется в бесконечность
+    return sign | 0x7C00;
+  }
+  if (magnitude < 0x38800000) {
+    // Денормализованные: у 0.5f шаг мантиссы 2^-24, как у денормализованных
+    // fp16, поэтому сложение само округляет к четному
+    float shifted = BitsFloat(magnitude) + 0.5f;
+    return sign | static_cast<uint16_t>(FloatBits(shifted) - 0x3F000000);
+  }
+  // Смена смещения порядка (127 -> 15) и округление к четному
+  magnitude += 0xC8000FFF + ((magnitude >> 13) & 1);
+  return sign | static_cast<uint16_t>(magnitude >> 13);
+}
+
+float HalfToFloat(uint16_t value) {
+  uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+  uint32_t exponent = (value >> 10) & 0x1F;
+  uint32_t mantissa = value & 0x3FF;
+  if (exponent == 0) {
+    float result = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign ? -result : result;
+  }
+  if (exponent == 31) {
+    return BitsFloat(sign | 0x7F800000 | (mantissa << 13));
+  }
+  return BitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+#ifdef S21_X86_KERNELS
+bool HasF16c() {
+  static const bool supported =
+      __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+  return supported;
+}
+
+// Аппаратное преобразование по 8 элементов; хвост - переносимым кодом
+__attribute__((target("avx,f16c"))) void EncodeHalfF16c(const double *src,
+                                                        uint16_t *dst,
+                                                        size_t count) {
+  size_t k = 0;
+  for (; k + 8 <= count; k += 8) {
+    __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(src + k));
+    __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(src + k + 4));
+    __m256 values = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + k),
+                     _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT));
+  }
+  for (; k < count; k++) {
+    dst[k] = FloatToHalf(static_cast<float>(src[k]));
+  }
+}
+
+__attribute__((target("avx,f16c"))) void DecodeHalfF16c(const uint16_t *src,
+                                                        float *dst,
+                                                        size_t count) {
+  size_t k = 0;
+  for (; k + 8 <= count; k += 8) {
+    __m128i values =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + k));
+    _mm256_storeu_ps(dst + k, _mm256_cvtph_ps(values));
+  }
+  for (; k < count; k++) {
+    dst[k] = HalfToFloat(src[k]);
+  }
+}
+#endif
+
+// C = A * B для закодированных A (m x k) и B (k x n). Панель B шириной
+// kPanelCols раскодируется один раз, строки A - на каждой панели заново:
+// это k чисел против k * kPanelCols умножений
+template <typename Accumulator>
+void MulKernel(const uint16_t *a, S21HalfFormat a_format, const uint16_t *b,
+               S21HalfFormat b_format, int m, int k, int n,
+               const std::vector<double *> &result) {
+  std::vector<float> panel;
+  for (int j0 = 0; j0 < n; j0 += kPanelCols) {
+    int width = std::min(kPanelCols, n - j0);
+    panel.resize(static_cast<size_t>(k) * width);
+    for (int p = 0; p < k; p++) {
+      S21HalfMatrix::Decode(b + static_cast<size_t>(p) * n + j0,
+                            panel.data() + static_cast<size_t>(p) * width,
+                            width, b_format);
+    }
+    S21ParallelFor(0, m, kParallelRows, [&](int, int begin, int end) {
+      std::vector<float> row(k);
+      std::vector<Accumulator> sums(width);
+      for (int i = begin; i < end; i++) {
+        S21HalfMatrix::Decode(a + static_cast<size_t>(i) * k, row.data(), k,
+                              a_format);
+        std::fill(sums.begin(), sums.end(), Accumulator(0));
+        for (int p = 0; p < k; p++) {
+          Accumulator value = row[p];
+          const float *b_row = panel.data() + static_cast<size_t>(p) * width;
+          for (int j = 0; j < width; j++) {
+            sums[j] += value * b_row[j];
+          }
+        }
+        std::copy(sums.begin(), sums.end(), result[i] + j0);
+      }
+    });
+  }
+}
+
+}  // namespace
+
+S21HalfMatrix::S21HalfMatrix(int rows, int cols, S21HalfFormat format)
+    : rows_(rows),
+      cols_(cols),
+      format_(format),
+      data_(static_cast<size_t>(rows) * cols) {}
+
+S21HalfMatrix::S21HalfMatrix(const S21Matrix &matrix, S21HalfFormat format)
+    : S21HalfMatrix(matrix.GetRows(), matrix.GetCols(), format) {
+  for (int i = 0; i < rows_; i++) {
+    Encode(&matrix(i, 0), data_.data() + static_cast<size_t>(i) * cols_,
+           cols_, format_);
+  }
+}
+
+int S21HalfMatrix::GetRows() const { return rows_; }
+
+int S21HalfMatrix::GetCols() const { return cols_; }
+
+S21HalfFormat S21HalfMatrix::GetFormat() const { return format_; }
+
+double S21HalfMatrix::GetElement(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  float value;
+  Decode(&data_[static_cast<size_t>(i) * cols_ + j], &value, 1, format_);
+  return value;
+}
+
+void S21HalfMatrix::SetElement(int i, int j, double value) {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  Encode(&value, &data_[static_cast<size_t>(i) * cols_ + j], 1, format_);
+}
+
+const uint16_t *S21HalfMatrix::Data() const { return data_.data(); }
+
+S21Matrix S21HalfMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  std::vector<float> row(cols_);
+  for (int i = 0; i < rows_; i++) {
+    Decode(data_.data() + static_cast<size_t>(i) * cols_, row.data(), cols_,
+           format_);
+    std::copy(row.begin(), row.end(), &result(i, 0));
+  }
+  return result;
+}
+
+template <typename Operation>
+S21HalfMatrix S21HalfMatrix::Combine(const S21HalfMatrix &other,
+                                     Operation operation) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+  S21HalfMatrix result(rows_, cols_, format_);
+  float left[kChunk], right[kChunk];
+  double values[kChunk];
+  for (size_t begin = 0; begin < data_.size(); begin += kChunk) {
+    size_t count = std::min(kChunk, data_.size() - begin);
+    Decode(data_.data() + begin, left, count, format_);
+    Decode(other.data_.data() + begin, right, count, other.format_);
+    for (size_t k = 0; k < count; k++) {
+      values[k] = operation(left[k], right[k]);
+    }
+    Encode(values, result.data_.data() + begin, count, format_);
+  }
+  return result;
+}
+
+S21HalfMatrix S21HalfMatrix::Sum(const S21HalfMatrix &other) const {
+  return Combine(other, [](float a, float b) { return a + b; });
+}
+
+S21HalfMatrix S21HalfMatrix::Sub(const S21HalfMatrix &other) const {
+  return Combine(other, [](float a, float b) { return a - b; });
+}
+
+S21HalfMatrix S21HalfMatrix::MulNumber(double num) const {
+  if (std::isnan(num) || std::isinf(num)) {
+    throw std::invalid_argument("Incorrect argument for multiplication.");
+  }
+  float factor = static_cast<float>(num);
+  return Combine(*this, [factor](float a, float) { return a * factor; });
+}
+
+S21Matrix S21HalfMatrix::Mul(const S21HalfMatrix &other,
+                             S21HalfAccumulator accumulator) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  S21Matrix result(rows_, other.cols_);
+  // Указатели на строки берутся заранее: потоки пишут в разные строки
+  std::vector<double *> rows(rows_);
+  for (int i = 0; i < rows_; i++) {
+    rows[i] = &result(i, 0);
+  }
+  if (accumulator == S21HalfAccumulator::kFloat) {
+    MulKernel<float>(data_.data(), format_, other.data_.data(), other.format_,
+                     rows_, cols_, other.cols_, rows);
+  } else {
+    MulKernel<double>(data_.data(), format_, other.data_.data(),
+                      other.format_, rows_, cols_, other.cols_, rows);
+  }
+  return result;
+}
+
+void S21HalfMatrix::Encode(const double *src, uint16_t *dst, size_t count,
+                           S21HalfFormat format) {
+  // Значения сначала округляются до float
+  if (format == S21HalfFormat::kBFloat16) {
+    for (size_t k = 0; k < count; k++) {
+      dst[k] = FloatToBFloat16(static_cast<float>(src[k]));
+    }
+    return;
+  }
+#ifdef S21_X86_KERNELS
+  if (HasF16c()) {
+    EncodeHalfF16c(src, dst, count);
+    return;
+  }
+#endif
+  for (size_t k = 0; k < count; k++) {
+    dst[k] = FloatToHalf(static_cast<float>(src[k]));
+  }
+}
+
+void S21HalfMatrix::Decode(const uint16_t *src, float *dst, size_t count,
+                           S21HalfFormat format) {
+  if (format == S21HalfFormat::kBFloat16) {
+    for (size_t k = 0; k < count; k++) {
+      dst[k] = BFloat16ToFloat(src[k]);
+    }
+    return;
+  }
+#ifdef S21_X86_KERNELS
+  if (HasF16c()) {
+    DecodeHalfF16c(src, dst, count);
+    return;
+  }
+#endif
+  for (size_t k = 0; k < count; k++) {
+    dst[k] = HalfToFloat(src[k]);
+  }
+}
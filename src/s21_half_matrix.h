@@ -0,0 +1,74 @@
+#ifndef SRC_S21_HALF_MATRIX_H_
+#define SRC_S21_HALF_MATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief 16-битный формат элементов
+enum class S21HalfFormat {
+  kBFloat16,  // 8 бит порядка, 7 бит мантиссы: диапазон float, ~3 знака
+  kFloat16    // IEEE binary16: 5 бит порядка, 10 бит мантиссы, до 65504
+};
+
+/// @brief Тип, в котором накапливаются суммы произведений
+enum class S21HalfAccumulator { kFloat, kDouble };
+
+/// @brief Матрица с 16-битными элементами: в 4 раза меньше памяти, чем у
+/// S21Matrix. Значения округляются к ближайшему (при равенстве - к четному),
+/// выходящие за диапазон формата становятся бесконечностью. Вычисления идут
+/// во float, результат округляется обратно только там, где он хранится в
+/// 16 битах
+class S21HalfMatrix {
+ public:
+  /// @brief Конвертирует матрицу в заданный формат
+  S21HalfMatrix(const S21Matrix &matrix, S21HalfFormat format);
+
+  int GetRows() const;
+  int GetCols() const;
+  S21HalfFormat GetFormat() const;
+
+  /// @brief Элемент после обратного преобразования
+  double GetElement(int i, int j) const;
+  void SetElement(int i, int j, double value);
+
+  /// @brief Закодированные элементы по строкам
+  const uint16_t *Data() const;
+
+  /// @brief Обратное преобразование в S21Matrix
+  S21Matrix ToMatrix() const;
+
+  /// @brief Поэлементные операции; результат в формате this
+  S21HalfMatrix Sum(const S21HalfMatrix &other) const;
+  S21HalfMatrix Sub(const S21HalfMatrix &other) const;
+  S21HalfMatrix MulNumber(double num) const;
+
+  /// @brief Произведение this * other. Блоки other раскодируются во float
+  /// один раз и используются всеми строками this
+  /// @param accumulator тип сумм: float быстрее, double точнее при
+  /// большой общей размерности
+  S21Matrix Mul(const S21HalfMatrix &other,
+                S21HalfAccumulator accumulator) const;
+
+  /// @brief Пакетное кодирование и декодирование. На x86 с F16C для fp16
+  /// используются аппаратные инструкции
+  static void Encode(const double *src, uint16_t *dst, size_t count,
+                     S21HalfFormat format);
+  static void Decode(const uint16_t *src, float *dst, size_t count,
+                     S21HalfFormat format);
+
+ private:
+  S21HalfMatrix(int rows, int cols, S21HalfFormat format);
+
+  template <typename Operation>
+  S21HalfMatrix Combine(const S21HalfMatrix &other, Operation operation) const;
+
+  int rows_;
+  int cols_;
+  S21HalfFormat format_;
+  std::vector<uint16_t> data_;
+};
+
+#endif  // SRC_S21_HALF_MATRIX_H_
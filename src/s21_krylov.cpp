@@ -0,0 +1,378 @@
+#include "s21_krylov.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+namespace {
+
+// Минимум строк на поток при умножении матрицы на вектор
+constexpr int kParallelRows = 64;
+
+double Dot(const std::vector<double> &x, const std::vector<double> &y) {
+  double sum = 0;
+  for (size_t k = 0; k < x.size(); k++) {
+    sum += x[k] * y[k];
+  }
+  return sum;
+}
+
+double Norm(const std::vector<double> &x) { return std::sqrt(Dot(x, x)); }
+
+// y += alpha * x
+void Axpy(double alpha, const std::vector<double> &x, std::vector<double> &y) {
+  for (size_t k = 0; k < x.size(); k++) {
+    y[k] += alpha * x[k];
+  }
+}
+
+void Precondition(const S21LinearOperator &m, const std::vector<double> &r,
+                  std::vector<double> &z) {
+  if (m) {
+    m(r, z);
+  } else {
+    z = r;
+  }
+}
+
+// r = b - A * x
+void Residual(const S21LinearOperator &a, const std::vector<double> &b,
+              const std::vector<double> &x, std::vector<double> &r) {
+  a(x, r);
+  for (size_t k = 0; k < b.size(); k++) {
+    r[k] = b[k] - r[k];
+  }
+}
+
+// Проверяет аргументы, ставит начальное приближение и возвращает невязку
+std::vector<double> Start(const S21LinearOperator &a,
+                          const std::vector<double> &b,
+                          const S21KrylovOptions &options,
+                          S21KrylovResult *result) {
+  if (b.empty() || !a ||
+      (!options.initial_guess.empty() &&
+       options.initial_guess.size() != b.size())) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  result->x = options.initial_guess.empty()
+                  ? std::vector<double>(b.size(), 0.0)
+                  : options.initial_guess;
+  std::vector<double> r(b.size());
+  Residual(a, b, result->x, r);
+  return r;
+}
+
+// Итоговая невязка считается заново, а не берется из рекурсии метода
+void Finish(const S21LinearOperator &a, const std::vector<double> &b,
+            double b_norm, double tolerance, S21KrylovResult *result) {
+  std::vector<double> r(b.size());
+  Residual(a, b, result->x, r);
+  result->residual = Norm(r) / b_norm;
+  result->converged = result->residual <= tolerance;
+}
+
+void CheckSquare(const S21Matrix &matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+}
+
+}  // namespace
+
+S21LinearOperator S21MatrixOperator(const S21Matrix &matrix) {
+  CheckSquare(matrix);
+  const S21Matrix *a = &matrix;
+  return [a](const std::vector<double> &x, std::vector<double> &y) {
+    int n = a->GetRows();
+    y.resize(n);
+    S21ParallelFor(0, n, kParallelRows, [&](int, int begin, int end) {
+      for (int i = begin; i < end; i++) {
+        const double *row = &(*a)(i, 0);
+        double sum = 0;
+        for (int j = 0; j < n; j++) {
+          sum += row[j] * x[j];
+        }
+        y[i] = sum;
+      }
+    });
+  };
+}
+
+S21JacobiPreconditioner::S21JacobiPreconditioner(const S21Matrix &matrix) {
+  CheckSquare(matrix);
+  inverse_diagonal_.resize(matrix.GetRows());
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    if (matrix(i, i) == 0) {
+      throw std::logic_error("Zero pivot in preconditioner.");
+    }
+    inverse_diagonal_[i] = 1.0 / matrix(i, i);
+  }
+}
+
+void S21JacobiPreconditioner::operator()(const std::vector<double> &r,
+                                         std::vector<double> &z) const {
+  z.resize(r.size());
+  for (size_t k = 0; k < r.size(); k++) {
+    z[k] = r[k] * inverse_diagonal_[k];
+  }
+}
+
+S21Ilu0Preconditioner::S21Ilu0Preconditioner(const S21Matrix &matrix)
+    : size_(matrix.GetRows()), row_begin_(1, 0), diagonal_(matrix.GetRows()) {
+  CheckSquare(matrix);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      // Диагональ входит в шаблон всегда, чтобы ноль на ней был замечен
+      if (matrix(i, j) != 0 || i == j) {
+        if (i == j) {
+          diagonal_[i] = static_cast<int>(columns_.size());
+        }
+        columns_.push_back(j);
+        values_.push_back(matrix(i, j));
+      }
+    }
+    row_begin_.push_back(static_cast<int>(columns_.size()));
+  }
+  // Вариант IKJ: строка i исключается предыдущими строками k, но меняются
+  // только позиции, уже присутствующие в строке i
+  std::vector<int> position(size_, -1);
+  for (int i = 0; i < size_; i++) {
+    for (int p = row_begin_[i]; p < row_begin_[i + 1]; p++) {
+      position[columns_[p]] = p;
+    }
+    for (int p = row_begin_[i]; p < diagonal_[i]; p++) {
+      int k = columns_[p];
+      values_[p] /= values_[diagonal_[k]];
+      for (int q = diagonal_[k] + 1; q < row_begin_[k + 1]; q++) {
+        if (position[columns_[q]] >= 0) {
+          values_[position[columns_[q]]] -= values_[p] * values_[q];
+        }
+      }
+    }
+    if (values_[diagonal_[i]] == 0 || !std::isfinite(values_[diagonal_[i]])) {
+      throw std::logic_error("Zero pivot in preconditioner.");
+    }
+    for (int p = row_begin_[i]; p < row_begin_[i + 1]; p++) {
+      position[columns_[p]] = -1;
+    }
+  }
+}
+
+void S21Ilu0Preconditioner::operator()(const std::vector<double> &r,
+                                       std::vector<double> &z) const {
+  z.resize(size_);
+  for (int i = 0; i < size_; i++) {
+    double sum = r[i];
+    for (int p = row_begin_[i]; p < diagonal_[i]; p++) {
+      sum -= values_[p] * z[columns_[p]];
+    }
+    z[i] = sum;
+  }
+  for (int i = size_ - 1; i >= 0; i--) {
+    double sum = z[i];
+    for (int p = diagonal_[i] + 1; p < row_begin_[i + 1]; p++) {
+      sum -= values_[p] * z[columns_[p]];
+    }
+    z[i] = sum / values_[diagonal_[i]];
+  }
+}
+
+S21KrylovResult S21ConjugateGradient(const S21LinearOperator &a,
+                                     const std::vector<double> &b,
+                                     const S21KrylovOptions &options,
+                                     const S21LinearOperator &preconditioner) {
+  S21KrylovResult result;
+  std::vector<double> r = Start(a, b, options, &result);
+  double b_norm = Norm(b);
+  if (b_norm == 0) {
+    std::fill(result.x.begin(), result.x.end(), 0.0);
+    result.converged = true;
+    return result;
+  }
+  std::vector<double> z(b.size()), ap(b.size());
+  Precondition(preconditioner, r, z);
+  std::vector<double> p = z;
+  double rz = Dot(r, z);
+  double residual = Norm(r) / b_norm;
+  while (residual > options.tolerance &&
+         result.iterations < options.max_iterations) {
+    a(p, ap);
+    result.iterations++;
+    double curvature = Dot(p, ap);
+    if (!(curvature > 0)) {
+      // A не положительно определена вдоль p
+      break;
+    }
+    double alpha = rz / curvature;
+    Axpy(alpha, p, result.x);
+    Axpy(-alpha, ap, r);
+    residual = Norm(r) / b_norm;
+    result.history.push_back(residual);
+    Precondition(preconditioner, r, z);
+    double rz_next = Dot(r, z);
+    double beta = rz_next / rz;
+    rz = rz_next;
+    for (size_t k = 0; k < p.size(); k++) {
+      p[k] = z[k] + beta * p[k];
+    }
+  }
+  Finish(a, b, b_norm, options.tolerance, &result);
+  return result;
+}
+
+S21KrylovResult S21BiCgStab(const S21LinearOperator &a,
+                            const std::vector<double> &b,
+                            const S21KrylovOptions &options,
+                            const S21LinearOperator &preconditioner) {
+  S21KrylovResult result;
+  std::vector<double> r = Start(a, b, options, &result);
+  double b_norm = Norm(b);
+  if (b_norm == 0) {
+    std::fill(result.x.begin(), result.x.end(), 0.0);
+    result.converged = true;
+    return result;
+  }
+  size_t n = b.size();
+  std::vector<double> shadow = r, p(n, 0.0), v(n, 0.0), y(n), s(n), z(n),
+                      t(n);
+  double rho = 1, alpha = 1, omega = 1;
+  double residual = Norm(r) / b_norm;
+  while (residual > options.tolerance &&
+         result.iterations < options.max_iterations) {
+    double rho_next = Dot(shadow, r);
+    if (rho_next == 0 || omega == 0) {
+      // Вырождение метода
+      break;
+    }
+    double beta = (rho_next / rho) * (alpha / omega);
+    rho = rho_next;
+    for (size_t k = 0; k < n; k++) {
+      p[k] = r[k] + beta * (p[k] - omega * v[k]);
+    }
+    Precondition(preconditioner, p, y);
+    a(y, v);
+    result.iterations++;
+    double shadow_v = Dot(shadow, v);
+    if (shadow_v == 0) {
+      break;
+    }
+    alpha = rho / shadow_v;
+    s = r;
+    Axpy(-alpha, v, s);
+    Axpy(alpha, y, result.x);
+    residual = Norm(s) / b_norm;
+    if (residual <= options.tolerance ||
+        result.iterations >= options.max_iterations) {
+      // Половины шага хватило
+      result.history.push_back(residual);
+      break;
+    }
+    Precondition(preconditioner, s, z);
+    a(z, t);
+    result.iterations++;
+    double tt = Dot(t, t);
+    omega = tt == 0 ? 0 : Dot(t, s) / tt;
+    Axpy(omega, z, result.x);
+    r = s;
+    Axpy(-omega, t, r);
+    residual = Norm(r) / b_norm;
+    result.history.push_back(residual);
+  }
+  Finish(a, b, b_norm, options.tolerance, &result);
+  return result;
+}
+
+S21KrylovResult S21Gmres(const S21LinearOperator &a,
+                         const std::vector<double> &b,
+                         const S21KrylovOptions &options,
+                         const S21LinearOperator &preconditioner) {
+  S21KrylovResult result;
+  std::vector<double> r = Start(a, b, options, &result);
+  double b_norm = Norm(b);
+  if (b_norm == 0) {
+    std::fill(result.x.begin(), result.x.end(), 0.0);
+    result.converged = true;
+    return result;
+  }
+  int m = std::max(1, options.restart);
+  size_t n = b.size();
+  // Базис Арнольди, верхняя матрица Хессенберга по столбцам и вращения
+  // Гивенса, приводящие ее к треугольной
+  std::vector<std::vector<double>> basis(m + 1, std::vector<double>(n));
+  std::vector<std::vector<double>> h(m, std::vector<double>(m + 1));
+  std::vector<double> cs(m), sn(m), g(m + 1), w(n), z(n);
+  double residual = Norm(r) / b_norm;
+  while (residual > options.tolerance &&
+         result.iterations < options.max_iterations) {
+    double beta = Norm(r);
+    for (size_t k = 0; k < n; k++) {
+      basis[0][k] = r[k] / beta;
+    }
+    std::fill(g.begin(), g.end(), 0.0);
+    g[0] = beta;
+    int steps = 0;
+    bool breakdown = false;
+    while (steps < m && result.iterations < options.max_iterations &&
+           !breakdown) {
+      int j = steps;
+      Precondition(preconditioner, basis[j], z);
+      a(z, w);
+      result.iterations++;
+      // Модифицированный Грам-Шмидт
+      for (int i = 0; i <= j; i++) {
+        h[j][i] = Dot(w, basis[i]);
+        Axpy(-h[j][i], basis[i], w);
+      }
+      h[j][j + 1] = Norm(w);
+      breakdown = h[j][j + 1] == 0;
+      if (!breakdown) {
+        for (size_t k = 0; k < n; k++) {
+          basis[j + 1][k] = w[k] / h[j][j + 1];
+        }
+      }
+      for (int i = 0; i < j; i++) {
+        double upper = cs[i] * h[j][i] + sn[i] * h[j][i + 1];
+        h[j][i + 1] = -sn[i] * h[j][i] + cs[i] * h[j][i + 1];
+        h[j][i] = upper;
+      }
+      double radius = std::hypot(h[j][j], h[j][j + 1]);
+      cs[j] = radius == 0 ? 1 : h[j][j] / radius;
+      sn[j] = radius == 0 ? 0 : h[j][j + 1] / radius;
+      h[j][j] = radius;
+      h[j][j + 1] = 0;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+      steps++;
+      residual = std::abs(g[j + 1]) / b_norm;
+      result.history.push_back(residual);
+      if (residual <= options.tolerance) {
+        break;
+      }
+    }
+    // x += M * (V * y), где H * y = g
+    std::vector<double> coefficients(steps);
+    for (int i = steps - 1; i >= 0; i--) {
+      double sum = g[i];
+      for (int k = i + 1; k < steps; k++) {
+        sum -= h[k][i] * coefficients[k];
+      }
+      coefficients[i] = h[i][i] == 0 ? 0 : sum / h[i][i];
+    }
+    std::fill(w.begin(), w.end(), 0.0);
+    for (int i = 0; i < steps; i++) {
+      Axpy(coefficients[i], basis[i], w);
+    }
+    Precondition(preconditioner, w, z);
+    Axpy(1.0, z, result.x);
+    Residual(a, b, result.x, r);
+    residual = Norm(r) / b_norm;
+    if (breakdown) {
+      break;
+    }
+  }
+  Finish(a, b, b_norm, options.tolerance, &result);
+  return result;
+}
@@ -0,0 +1,102 @@
+#ifndef SRC_S21_KRYLOV_H_
+#define SRC_S21_KRYLOV_H_
+
+#include <functional>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Линейный оператор y = A * x. y уже имеет размер x. Подходит
+/// любая функция или объект с таким operator(), в том числе предобуславливатели
+using S21LinearOperator =
+    std::function<void(const std::vector<double> &x, std::vector<double> &y)>;
+
+/// @brief Параметры итерационных решателей
+struct S21KrylovOptions {
+  /// @brief Остановка, когда ||b - A * x|| <= tolerance * ||b||
+  double tolerance = 1e-10;
+  /// @brief Предел умножений на A
+  int max_iterations = 1000;
+  /// @brief Размер подпространства GMRES до перезапуска; память решателя
+  /// - (restart + 4) векторов
+  int restart = 30;
+  /// @brief Начальное приближение; пустое - нулевой вектор
+  std::vector<double> initial_guess;
+};
+
+/// @brief Решение и статистика сходимости
+struct S21KrylovResult {
+  std::vector<double> x;
+  bool converged = false;
+  int iterations = 0;
+  /// @brief Итоговая относительная невязка ||b - A * x|| / ||b||
+  double residual = 0;
+  /// @brief Относительная невязка после каждой итерации
+  std::vector<double> history;
+};
+
+/// @brief Оператор умножения на квадратную матрицу, строки обрабатываются
+/// параллельно. Матрица не копируется и должна жить дольше оператора
+/// @throw std::logic_error матрица не квадратная
+S21LinearOperator S21MatrixOperator(const S21Matrix &matrix);
+
+/// @brief Предобуславливатель Якоби: z = r / diag(A)
+class S21JacobiPreconditioner {
+ public:
+  /// @throw std::logic_error матрица не квадратная или на диагонали ноль
+  explicit S21JacobiPreconditioner(const S21Matrix &matrix);
+
+  void operator()(const std::vector<double> &r, std::vector<double> &z) const;
+
+ private:
+  std::vector<double> inverse_diagonal_;
+};
+
+/// @brief Неполное LU-разложение ILU(0): L * U без заполнения, то есть
+/// только на ненулевых позициях A. Хранится в сжатом построчном виде, так
+/// что применение стоит O(ненулевых элементов)
+class S21Ilu0Preconditioner {
+ public:
+  /// @throw std::logic_error матрица не квадратная или нулевой ведущий
+  /// элемент
+  explicit S21Ilu0Preconditioner(const S21Matrix &matrix);
+
+  /// @brief z = U^-1 * L^-1 * r
+  void operator()(const std::vector<double> &r, std::vector<double> &z) const;
+
+ private:
+  int size_;
+  std::vector<int> row_begin_;  // начало строки в columns_ и values_
+  std::vector<int> diagonal_;   // позиция диагонального элемента строки
+  std::vector<int> columns_;
+  std::vector<double> values_;  // L ниже диагонали (единицы не хранятся), U
+};
+
+/// @brief Метод сопряженных градиентов для симметричных положительно
+/// определенных A. Предобуславливатель тоже должен быть симметричным
+/// положительно определенным (Якоби подходит)
+/// @param a оператор A
+/// @param b правая часть
+/// @param preconditioner приближение A^-1 или пустой для M = I
+/// @throw std::invalid_argument пустая b или начальное приближение другого
+/// размера
+S21KrylovResult S21ConjugateGradient(
+    const S21LinearOperator &a, const std::vector<double> &b,
+    const S21KrylovOptions &options = {},
+    const S21LinearOperator &preconditioner = nullptr);
+
+/// @brief BiCGSTAB для несимметричных A с правым предобуславливанием. На
+/// итерацию - два умножения на A, они и считаются в iterations
+S21KrylovResult S21BiCgStab(const S21LinearOperator &a,
+                            const std::vector<double> &b,
+                            const S21KrylovOptions &options = {},
+                            const S21LinearOperator &preconditioner = nullptr);
+
+/// @brief GMRES с перезапусками и правым предобуславливанием: невязка не
+/// растет от итерации к итерации
+S21KrylovResult S21Gmres(const S21LinearOperator &a,
+                         const std::vector<double> &b,
+                         const S21KrylovOptions &options = {},
+                         const S21LinearOperator &preconditioner = nullptr);
+
+#endif  // SRC_S21_KRYLOV_H_
@@ -0,0 +1,214 @@
+#include "s21_low_rank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon();
+// Предел вращений Якоби по всем парам столбцов
+constexpr int kMaxSweeps = 60;
+
+// Один проход по A: visit(first_row, panel) для каждой панели строк
+template <typename Visit>
+void ForEachPanel(int rows, int cols, const S21RowPanelReader &reader,
+                  int panel_rows, Visit visit) {
+  S21Matrix panel(std::min(panel_rows, rows), cols);
+  for (int first = 0; first < rows; first += panel_rows) {
+    int count = std::min(panel_rows, rows - first);
+    if (count != panel.GetRows()) {
+      panel = S21Matrix(count, cols);
+    }
+    reader(first, panel);
+    visit(first, panel);
+  }
+}
+
+S21Matrix CopyRows(const S21Matrix &source, int first, int count) {
+  S21Matrix result(count, source.GetCols());
+  for (int i = 0; i < count; i++) {
+    std::copy(&source(first + i, 0), &source(first + i, 0) + source.GetCols(),
+              &result(i, 0));
+  }
+  return result;
+}
+
+void PasteRows(const S21Matrix &block, int first, S21Matrix *target) {
+  for (int i = 0; i < block.GetRows(); i++) {
+    std::copy(&block(i, 0), &block(i, 0) + block.GetCols(),
+              &(*target)(first + i, 0));
+  }
+}
+
+// Ортонормированный базис столбцов
+S21Matrix Orthonormalize(const S21Matrix &y) {
+  S21Matrix q, r;
+  y.QRDecomposition(q, r);
+  return q;
+}
+
+// Одностороннее вращение Якоби столбцов m (n x l) до взаимной
+// ортогональности: m * rotation = w * diag(sigma) с ортонормированными w.
+// На выходе столбцы m нормированы, sigma - их прежние длины
+void OneSidedJacobi(std::vector<std::vector<double>> &m,
+                    std::vector<std::vector<double>> &rotation,
+                    std::vector<double> &sigma) {
+  int l = static_cast<int>(m.size());
+  rotation.assign(l, std::vector<double>(l, 0.0));
+  for (int j = 0; j < l; j++) {
+    rotation[j][j] = 1.0;
+  }
+  auto dot = [](const std::vector<double> &x, const std::vector<double> &y) {
+    return std::inner_product(x.begin(), x.end(), y.begin(), 0.0);
+  };
+  auto rotate = [](std::vector<double> &x, std::vector<double> &y, double c,
+                   double s) {
+    for (size_t k = 0; k < x.size(); k++) {
+      double xk = x[k];
+      x[k] = c * xk - s * y[k];
+      y[k] = s * xk + c * y[k];
+    }
+  };
+  bool rotated = true;
+  for (int sweep = 0; sweep < kMaxSweeps && rotated; sweep++) {
+    rotated = false;
+    for (int p = 0; p < l; p++) {
+      for (int q = p + 1; q < l; q++) {
+        double alpha = dot(m[p], m[p]);
+        double beta = dot(m[q], m[q]);
+        double gamma = dot(m[p], m[q]);
+        if (std::abs(gamma) <= kEpsilon * std::sqrt(alpha * beta)) {
+          continue;
+        }
+        rotated = true;
+        double zeta = (beta - alpha) / (2 * gamma);
+        double t = (zeta >= 0 ? 1.0 : -1.0) /
+                   (std::abs(zeta) + std::sqrt(1 + zeta * zeta));
+        double c = 1 / std::sqrt(1 + t * t);
+        double s = c * t;
+        rotate(m[p], m[q], c, s);
+        rotate(rotation[p], rotation[q], c, s);
+      }
+    }
+  }
+  sigma.resize(l);
+  for (int j = 0; j < l; j++) {
+    sigma[j] = std::sqrt(dot(m[j], m[j]));
+    for (double &value : m[j]) {
+      value = sigma[j] > 0 ? value / sigma[j] : 0.0;
+    }
+  }
+}
+
+}  // namespace
+
+S21LowRank S21RandomizedSvd(const S21Matrix &a, int rank,
+                            const S21LowRankOptions &options) {
+  auto reader = [&a](int first_row, S21Matrix &panel) {
+    for (int i = 0; i < panel.GetRows(); i++) {
+      std::copy(&a(first_row + i, 0), &a(first_row + i, 0) + a.GetCols(),
+                &panel(i, 0));
+    }
+  };
+  return S21RandomizedSvd(a.GetRows(), a.GetCols(), reader, rank, options);
+}
+
+S21LowRank S21RandomizedSvd(int rows, int cols,
+                            const S21RowPanelReader &reader, int rank,
+                            const S21LowRankOptions &options) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+  if (rank < 1 || rank > std::min(rows, cols) || !reader) {
+    throw std::invalid_argument("Invalid rank for low-rank approximation.");
+  }
+  int l = std::min(rank + std::max(0, options.oversampling),
+                   std::min(rows, cols));
+  int panel_rows = std::max(1, options.panel_rows);
+  S21LowRank result;
+
+  std::mt19937_64 generator(options.seed);
+  std::normal_distribution<double> normal;
+  S21Matrix sketch(cols, l);
+  for (int i = 0; i < cols; i++) {
+    for (int j = 0; j < l; j++) {
+      sketch(i, j) = normal(generator);
+    }
+  }
+
+  // Y = A * X
+  S21Matrix y(rows, l);
+  auto multiply = [&](const S21Matrix &x) {
+    ForEachPanel(rows, cols, reader, panel_rows,
+                 [&](int first, const S21Matrix &panel) {
+                   PasteRows(panel * x, first, &y);
+                 });
+    result.passes++;
+  };
+  multiply(sketch);
+  for (int step = 0; step < options.power_iterations; step++) {
+    // Z = A^T * Q; ортогонализация на каждом шаге не дает малым
+    // сингулярным числам утонуть в округлении
+    S21Matrix q = Orthonormalize(y);
+    S21Matrix z(cols, l);
+    ForEachPanel(rows, cols, reader, panel_rows,
+                 [&](int first, const S21Matrix &panel) {
+                   z += panel.Transpose() *
+                        CopyRows(q, first, panel.GetRows());
+                 });
+    result.passes++;
+    multiply(Orthonormalize(z));
+  }
+
+  // B = Q^T * A, заодно ||A||^2 для оценки ошибки
+  S21Matrix q = Orthonormalize(y);
+  S21Matrix b(l, cols);
+  double total = 0;
+  ForEachPanel(rows, cols, reader, panel_rows,
+               [&](int first, const S21Matrix &panel) {
+                 b += CopyRows(q, first, panel.GetRows()).Transpose() * panel;
+                 double norm = panel.NormFrobenius();
+                 total += norm * norm;
+               });
+  result.passes++;
+
+  // B^T = W * diag(sigma) * R^T, значит A ~ (Q * R) * diag(sigma) * W^T
+  std::vector<std::vector<double>> columns(l, std::vector<double>(cols));
+  for (int j = 0; j < l; j++) {
+    for (int k = 0; k < cols; k++) {
+      columns[j][k] = b(j, k);
+    }
+  }
+  std::vector<std::vector<double>> rotation;
+  std::vector<double> sigma;
+  OneSidedJacobi(columns, rotation, sigma);
+  std::vector<int> order(l);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&sigma](int x, int y) { return sigma[x] > sigma[y]; });
+
+  S21Matrix small(l, rank);
+  result.singular_values = S21Matrix(rank, 1);
+  result.v = S21Matrix(cols, rank);
+  double kept = 0;
+  for (int j = 0; j < rank; j++) {
+    int source = order[j];
+    result.singular_values(j, 0) = sigma[source];
+    kept += sigma[source] * sigma[source];
+    for (int i = 0; i < l; i++) {
+      small(i, j) = rotation[source][i];
+    }
+    for (int k = 0; k < cols; k++) {
+      result.v(k, j) = columns[source][k];
+    }
+  }
+  result.u = q * small;
+  result.error = std::sqrt(std::max(0.0, total - kept));
+  return result;
+}
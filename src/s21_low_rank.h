@@ -0,0 +1,59 @@
+#ifndef SRC_S21_LOW_RANK_H_
+#define SRC_S21_LOW_RANK_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Параметры рандомизированного SVD
+struct S21LowRankOptions {
+  /// @brief Сколько столбцов скетча добавляется к рангу: чем больше, тем
+  /// ближе результат к точному усеченному SVD
+  int oversampling = 10;
+  /// @brief Степенные итерации (A * A^T)^q * A * G: нужны при медленно
+  /// убывающих сингулярных числах, каждая стоит двух проходов по A
+  int power_iterations = 2;
+  /// @brief Строк в одной панели при проходе по A
+  int panel_rows = 256;
+  /// @brief Зерно генератора гауссовой матрицы; одинаковое зерно дает
+  /// одинаковый результат
+  uint64_t seed = 0;
+};
+
+/// @brief Приближение ранга k: A ~ u * diag(singular_values) * v^T
+struct S21LowRank {
+  S21Matrix u;                // левые сингулярные векторы (rows x k)
+  S21Matrix singular_values;  // по убыванию (k x 1)
+  S21Matrix v;                // правые сингулярные векторы (cols x k)
+  /// @brief ||A - u * diag(s) * v^T|| по Фробениусу. Приближение -
+  /// ортогональная проекция A, поэтому ошибка равна
+  /// sqrt(||A||^2 - sum(s^2)); точность ограничена вычитанием, примерно
+  /// sqrt(eps) * ||A||
+  double error = 0;
+  int passes = 0;  // сколько раз прочитана A
+};
+
+/// @brief Источник строк матрицы: заполняет panel (panel.GetRows() x cols)
+/// строками начиная с first_row. Позволяет работать с данными, которые не
+/// помещаются в память: файлом, отображенным в память, или потоком,
+/// который можно перечитать
+using S21RowPanelReader = std::function<void(int first_row, S21Matrix &panel)>;
+
+/// @brief Рандомизированное SVD: Y = A * G для гауссовой G (cols x l,
+/// l = rank + oversampling), степенные итерации с переортогонализацией,
+/// Q = qr(Y), B = Q^T * A и SVD маленькой B односторонним методом Якоби.
+/// Время O(rows * cols * l), A читается 2 + 2 * power_iterations раз
+/// @param a исходная матрица
+/// @param rank сколько сингулярных троек вернуть
+/// @throw std::invalid_argument rank вне [1, min(rows, cols)]
+S21LowRank S21RandomizedSvd(const S21Matrix &a, int rank,
+                            const S21LowRankOptions &options = {});
+
+/// @brief То же для матрицы rows x cols, читаемой панелями строк. В памяти
+/// держатся одна панель и матрицы размера (rows + cols) x l
+S21LowRank S21RandomizedSvd(int rows, int cols,
+                            const S21RowPanelReader &reader, int rank,
+                            const S21LowRankOptions &options = {});
+
+#endif  // SRC_S21_LOW_RANK_H_
@@ -0,0 +1,335 @@
+#include "s21_matrix_async.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// Вершина графа. Ребра в обе стороны держат shared_ptr: потребитель держит
+// свои аргументы, пока не выполнится, а аргумент держит потребителей, пока
+// не разбудит их. Оба списка очищаются после выполнения, поэтому циклов не
+// остается, и результат живет ровно до последнего потребителя
+struct S21MatrixFuture::Node {
+  S21MatrixExecutor::Task task;
+  std::vector<std::shared_ptr<Node>> inputs;
+  std::vector<std::shared_ptr<Node>> dependents;
+  std::atomic<int> pending{0};
+  S21MatrixExecutor::Scheduler *scheduler = nullptr;
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  bool done = false;
+  std::unique_ptr<S21Matrix> result;
+  std::exception_ptr error;
+};
+
+// Пул потоков с перехватом задач: у каждого потока своя очередь, новые
+// задачи кладутся в очередь текущего потока и берутся с ее конца (последняя
+// порожденная задача работает с еще горячими в кэше данными), а простаивающий
+// поток забирает задачи с начала чужих очередей
+class S21MatrixExecutor::Scheduler {
+ public:
+  using NodePtr = std::shared_ptr<S21MatrixFuture::Node>;
+
+  explicit Scheduler(int threads) {
+    if (threads <= 0) {
+      threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threads = std::max(1, threads);
+    for (int i = 0; i < threads; i++) {
+      queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < threads; i++) {
+      workers_.emplace_back(&Scheduler::WorkerLoop, this, i);
+    }
+  }
+
+  ~Scheduler() {
+    WaitAll();
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  int Threads() const { return static_cast<int>(workers_.size()); }
+
+  // Регистрирует вершину в графе: считает невыполненные аргументы и
+  // подписывается на них. Вершина без ожидания сразу попадает в очередь
+  S21MatrixFuture Add(NodePtr node) {
+    node->scheduler = this;
+    outstanding_.fetch_add(1);
+    // Лишняя единица не дает вершине запуститься, пока идет подписка
+    node->pending.store(1);
+    for (const NodePtr &input : node->inputs) {
+      std::lock_guard<std::mutex> lock(input->mutex);
+      if (!input->done) {
+        input->dependents.push_back(node);
+        node->pending.fetch_add(1);
+      }
+    }
+    if (node->pending.fetch_sub(1) == 1) {
+      Schedule(node);
+    }
+    return S21MatrixFuture(node);
+  }
+
+  void WaitAll() {
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    all_done_.wait(lock, [this] { return outstanding_.load() == 0; });
+  }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<NodePtr> tasks;
+  };
+
+  void Schedule(const NodePtr &node) {
+    size_t index = current_ == this
+                       ? current_index_
+                       : next_queue_.fetch_add(1) % queues_.size();
+    {
+      std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+      queues_[index]->tasks.push_back(node);
+    }
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      queued_++;
+    }
+    wake_.notify_one();
+  }
+
+  NodePtr Take(size_t index) {
+    {
+      WorkerQueue &own = *queues_[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        NodePtr node = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        return node;
+      }
+    }
+    for (size_t shift = 1; shift < queues_.size(); shift++) {
+      WorkerQueue &other = *queues_[(index + shift) % queues_.size()];
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (!other.tasks.empty()) {
+        NodePtr node = std::move(other.tasks.front());
+        other.tasks.pop_front();
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  void WorkerLoop(size_t index) {
+    current_ = this;
+    current_index_ = index;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+        if (stop_ && queued_ == 0) {
+          return;
+        }
+        queued_--;
+      }
+      // Задача гарантированно есть в одной из очередей
+      NodePtr node;
+      while (node == nullptr) {
+        node = Take(index);
+      }
+      Run(node);
+    }
+  }
+
+  void Run(const NodePtr &node) {
+    std::unique_ptr<S21Matrix> result;
+    std::exception_ptr error;
+    std::vector<const S21Matrix *> arguments;
+    for (const NodePtr &input : node->inputs) {
+      if (input->error) {
+        error = input->error;
+        break;
+      }
+      arguments.push_back(input->result.get());
+    }
+    if (!error) {
+      try {
+        result = std::make_unique<S21Matrix>(node->task(arguments));
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+    // Аргументы больше не нужны, последний потребитель освобождает их
+    node->inputs.clear();
+    node->task = nullptr;
+    std::vector<NodePtr> dependents;
+    {
+      std::lock_guard<std::mutex> lock(node->mutex);
+      node->result = std::move(result);
+      node->error = error;
+      node->done = true;
+      dependents.swap(node->dependents);
+    }
+    node->finished.notify_all();
+    for (const NodePtr &dependent : dependents) {
+      if (dependent->pending.fetch_sub(1) == 1) {
+        dependent->scheduler->Schedule(dependent);
+      }
+    }
+    if (outstanding_.fetch_sub(1) == 1) {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      all_done_.notify_all();
+    }
+  }
+
+  static thread_local Scheduler *current_;
+  static thread_local size_t current_index_;
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> next_queue_{0};
+  std::atomic<int> outstanding_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable all_done_;
+  int queued_ = 0;
+  bool stop_ = false;
+};
+
+thread_local S21MatrixExecutor::Scheduler
+    *S21MatrixExecutor::Scheduler::current_ = nullptr;
+thread_local size_t S21MatrixExecutor::Scheduler::current_index_ = 0;
+
+S21MatrixFuture::S21MatrixFuture() = default;
+
+S21MatrixFuture::S21MatrixFuture(std::shared_ptr<Node> node)
+    : node_(std::move(node)) {}
+
+bool S21MatrixFuture::Valid() const { return node_ != nullptr; }
+
+bool S21MatrixFuture::Ready() const {
+  if (node_ == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(node_->mutex);
+  return node_->done;
+}
+
+void S21MatrixFuture::Wait() const {
+  if (node_ == nullptr) {
+    throw std::logic_error("Future is not associated with an operation.");
+  }
+  std::unique_lock<std::mutex> lock(node_->mutex);
+  node_->finished.wait(lock, [this] { return node_->done; });
+}
+
+S21Matrix S21MatrixFuture::Get() const {
+  Wait();
+  if (node_->error) {
+    std::rethrow_exception(node_->error);
+  }
+  return *node_->result;
+}
+
+S21MatrixExecutor::S21MatrixExecutor(int threads)
+    : scheduler_(std::make_unique<Scheduler>(threads)) {}
+
+S21MatrixExecutor::~S21MatrixExecutor() = default;
+
+int S21MatrixExecutor::GetThreads() const { return scheduler_->Threads(); }
+
+void S21MatrixExecutor::WaitAll() { scheduler_->WaitAll(); }
+
+S21MatrixFuture S21MatrixExecutor::Constant(S21Matrix matrix) {
+  auto node = std::make_shared<S21MatrixFuture::Node>();
+  // Результат читают несколько потоков сразу, кэш ему не нужен
+  matrix.SetCaching(false);
+  node->result = std::make_unique<S21Matrix>(std::move(matrix));
+  node->done = true;
+  return S21MatrixFuture(node);
+}
+
+S21MatrixFuture S21MatrixExecutor::Submit(
+    Task task, const std::vector<S21MatrixFuture> &inputs) {
+  auto node = std::make_shared<S21MatrixFuture::Node>();
+  node->task = std::move(task);
+  for (const S21MatrixFuture &input : inputs) {
+    if (!input.Valid()) {
+      throw std::invalid_argument(
+          "Future is not associated with an operation.");
+    }
+    node->inputs.push_back(input.node_);
+  }
+  return scheduler_->Add(node);
+}
+
+S21MatrixFuture S21MatrixExecutor::Sum(const S21MatrixFuture &a,
+                                       const S21MatrixFuture &b) {
+  return Submit(
+      [](const std::vector<const S21Matrix *> &args) {
+        return *args[0] + *args[1];
+      },
+      {a, b});
+}
+
+S21MatrixFuture S21MatrixExecutor::Sub(const S21MatrixFuture &a,
+                                       const S21MatrixFuture &b) {
+  return Submit(
+      [](const std::vector<const S21Matrix *> &args) {
+        return *args[0] - *args[1];
+      },
+      {a, b});
+}
+
+S21MatrixFuture S21MatrixExecutor::Mul(const S21MatrixFuture &a,
+                                       const S21MatrixFuture &b) {
+  return Submit(
+      [](const std::vector<const S21Matrix *> &args) {
+        return *args[0] * *args[1];
+      },
+      {a, b});
+}
+
+S21MatrixFuture S21MatrixExecutor::MulNumber(const S21MatrixFuture &a,
+                                             double num) {
+  return Submit(
+      [num](const std::vector<const S21Matrix *> &args) {
+        S21Matrix result(*args[0]);
+        result.MulNumber(num);
+        return result;
+      },
+      {a});
+}
+
+S21MatrixFuture S21MatrixExecutor::Transpose(const S21MatrixFuture &a) {
+  return Submit(
+      [](const std::vector<const S21Matrix *> &args) {
+        return args[0]->Transpose();
+      },
+      {a});
+}
+
+S21MatrixFuture S21MatrixExecutor::CalcComplements(const S21MatrixFuture &a) {
+  return Submit(
+      [](const std::vector<const S21Matrix *> &args) {
+        return args[0]->CalcComplements();
+      },
+      {a});
+}
+
+S21MatrixFuture S21MatrixExecutor::InverseMatrix(const S21MatrixFuture &a) {
+  return Submit(
+      [](const std::vector<const S21Matrix *> &args) {
+        return args[0]->InverseMatrix();
+      },
+      {a});
+}
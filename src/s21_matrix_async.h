@@ -0,0 +1,89 @@
+#ifndef SRC_S21_MATRIX_ASYNC_H_
+#define SRC_S21_MATRIX_ASYNC_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Будущий результат операции над матрицами. Копии ссылаются на один
+/// и тот же узел графа вычислений
+class S21MatrixFuture {
+ public:
+  /// @brief Пустой результат, не связанный ни с какой операцией
+  S21MatrixFuture();
+
+  /// @brief Связан ли результат с операцией
+  bool Valid() const;
+
+  /// @brief Вычислен ли уже результат (или завершился ли он ошибкой)
+  bool Ready() const;
+
+  /// @brief Ожидание завершения операции
+  void Wait() const;
+
+  /// @brief Ожидает и возвращает результат. Исключение, выброшенное
+  /// операцией или любой из ее зависимостей, пробрасывается отсюда
+  S21Matrix Get() const;
+
+ private:
+  friend class S21MatrixExecutor;
+  struct Node;
+
+  explicit S21MatrixFuture(std::shared_ptr<Node> node);
+
+  std::shared_ptr<Node> node_;
+};
+
+/// @brief Исполнитель графа операций над матрицами. Операции сразу
+/// возвращают S21MatrixFuture и запускаются, как только готовы их аргументы;
+/// независимые ветви выполняются параллельно пулом потоков с перехватом
+/// задач. Промежуточный результат освобождается, когда его забрал последний
+/// потребитель и на него не осталось S21MatrixFuture у вызывающего кода
+class S21MatrixExecutor {
+ public:
+  /// @brief Функция операции, получает результаты зависимостей по порядку
+  using Task = std::function<S21Matrix(const std::vector<const S21Matrix *> &)>;
+
+  /// @brief Конструктор
+  /// @param threads кол-во рабочих потоков (0 - по числу ядер)
+  explicit S21MatrixExecutor(int threads = 0);
+
+  S21MatrixExecutor(const S21MatrixExecutor &other) = delete;
+  S21MatrixExecutor &operator=(const S21MatrixExecutor &other) = delete;
+
+  ~S21MatrixExecutor();  // Деструктор, дожидается всех операций
+
+  /// @brief Готовое значение как вершина графа
+  /// @param matrix матрица, переносится в граф
+  S21MatrixFuture Constant(S21Matrix matrix);
+
+  /// @brief Произвольная операция с зависимостями
+  /// @param task функция операции
+  /// @param inputs результаты, которые нужны операции
+  S21MatrixFuture Submit(Task task, const std::vector<S21MatrixFuture> &inputs);
+
+  /// @brief Асинхронные версии операций S21Matrix
+  S21MatrixFuture Sum(const S21MatrixFuture &a, const S21MatrixFuture &b);
+  S21MatrixFuture Sub(const S21MatrixFuture &a, const S21MatrixFuture &b);
+  S21MatrixFuture Mul(const S21MatrixFuture &a, const S21MatrixFuture &b);
+  S21MatrixFuture MulNumber(const S21MatrixFuture &a, double num);
+  S21MatrixFuture Transpose(const S21MatrixFuture &a);
+  S21MatrixFuture CalcComplements(const S21MatrixFuture &a);
+  S21MatrixFuture InverseMatrix(const S21MatrixFuture &a);
+
+  /// @brief Ожидание завершения всех отправленных операций
+  void WaitAll();
+
+  /// @brief Кол-во рабочих потоков
+  int GetThreads() const;
+
+ private:
+  friend class S21MatrixFuture;
+  class Scheduler;
+
+  std::unique_ptr<Scheduler> scheduler_;
+};
+
+#endif  // SRC_S21_MATRIX_ASYNC_H_
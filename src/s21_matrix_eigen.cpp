@@ -0,0 +1,512 @@
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+// До этого размера используется метод Якоби: на маленьких матрицах он
+// быстрее и точнее трехдиагонализации. Работы в нем так мало, что запуск
+// потоков не окупается, и он идет в вызывающем потоке
+constexpr int kJacobiMaxSize = 16;
+constexpr int kJacobiMaxSweeps = 100;
+// Предел итераций QL на одно собственное значение, как в tql2
+constexpr int kQLMaxIterations = 30;
+constexpr int kInverseIterations = 3;
+constexpr double kSymmetryTolerance = 1e-9;
+constexpr double kEpsilon = std::numeric_limits<double>::epsilon();
+
+// Квадратная матрица в виде одного массива по строкам
+struct Dense {
+  int n;
+  std::vector<double> data;
+
+  explicit Dense(int size)
+      : n(size), data(static_cast<size_t>(size) * size, 0.0) {}
+
+  double &operator()(int i, int j) {
+    return data[static_cast<size_t>(i) * n + j];
+  }
+  double operator()(int i, int j) const {
+    return data[static_cast<size_t>(i) * n + j];
+  }
+};
+
+// Вращение Якоби в плоскости (p, q)
+struct Rotation {
+  int p;
+  int q;
+  double c;
+  double s;
+};
+
+// Циклический метод Якоби с порядком "круговой турнир": за один раунд
+// вращаются n/2 непересекающихся пар. Углы раунда считаются до вращений,
+// затем все пары поворачивают свои столбцы, потом свои строки
+void Jacobi(Dense &a, std::vector<double> &values, Dense *vectors) {
+  int n = a.n;
+  if (vectors != nullptr) {
+    for (int i = 0; i < n; i++) {
+      (*vectors)(i, i) = 1.0;
+    }
+  }
+  // Для нечетного n добавляется фиктивный участник турнира
+  int players = n % 2 == 0 ? n : n + 1;
+  std::vector<int> order(players);
+  for (int i = 0; i < players; i++) {
+    order[i] = i;
+  }
+  double norm = 0.0;
+  for (double value : a.data) {
+    norm += value * value;
+  }
+  std::vector<Rotation> rotations(players / 2);
+  for (int sweep = 0; sweep < kJacobiMaxSweeps; sweep++) {
+    double off = 0.0;
+    for (int i = 0; i < n; i++) {
+      for (int j = i + 1; j < n; j++) {
+        off += 2.0 * a(i, j) * a(i, j);
+      }
+    }
+    if (off <= kEpsilon * kEpsilon * norm) {
+      break;
+    }
+    for (int round = 0; round < players - 1; round++) {
+      // Блоки 2 x 2 разных пар не пересекаются, поэтому все углы раунда
+      // можно взять из матрицы до вращений
+      int count = 0;
+      for (int k = 0; k < players / 2; k++) {
+        int p = std::min(order[k], order[players - 1 - k]);
+        int q = std::max(order[k], order[players - 1 - k]);
+        if (q >= n || a(p, q) == 0.0) {
+          continue;
+        }
+        double theta = (a(q, q) - a(p, p)) / (2.0 * a(p, q));
+        double t = std::copysign(1.0, theta) /
+                   (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        double c = 1.0 / std::sqrt(t * t + 1.0);
+        rotations[count++] = {p, q, c, t * c};
+      }
+      // A * J: пара меняет только свои столбцы a и векторов
+      for (int r = 0; r < count; r++) {
+        const Rotation &rot = rotations[r];
+        for (int i = 0; i < n; i++) {
+          double aip = a(i, rot.p);
+          double aiq = a(i, rot.q);
+          a(i, rot.p) = rot.c * aip - rot.s * aiq;
+          a(i, rot.q) = rot.s * aip + rot.c * aiq;
+        }
+        for (int i = 0; vectors != nullptr && i < n; i++) {
+          double vip = (*vectors)(i, rot.p);
+          double viq = (*vectors)(i, rot.q);
+          (*vectors)(i, rot.p) = rot.c * vip - rot.s * viq;
+          (*vectors)(i, rot.q) = rot.s * vip + rot.c * viq;
+        }
+      }
+      // J^T * (A * J): пара меняет только свои строки
+      for (int r = 0; r < count; r++) {
+        const Rotation &rot = rotations[r];
+        for (int j = 0; j < n; j++) {
+          double apj = a(rot.p, j);
+          double aqj = a(rot.q, j);
+          a(rot.p, j) = rot.c * apj - rot.s * aqj;
+          a(rot.q, j) = rot.s * apj + rot.c * aqj;
+        }
+      }
+      // Сдвиг участников по кругу, первый остается на месте
+      std::rotate(order.begin() + 1, order.end() - 1, order.end());
+    }
+  }
+  values.resize(n);
+  for (int i = 0; i < n; i++) {
+    values[i] = a(i, i);
+  }
+}
+
+// Приведение к трехдиагональному виду отражениями Хаусхолдера:
+// A = Q * T * Q^T. Векторы отражений остаются в столбцах под поддиагональю,
+// их коэффициенты - в tau. d - диагональ T, e[i] = T(i + 1, i)
+void Tridiagonalize(Dense &a, std::vector<double> &d, std::vector<double> &e,
+                    std::vector<double> &tau) {
+  int n = a.n;
+  d.assign(n, 0.0);
+  e.assign(n, 0.0);
+  tau.assign(n, 0.0);
+  std::vector<double> v(n);
+  std::vector<double> w(n);
+  for (int k = 0; k + 2 < n; k++) {
+    double alpha = a(k + 1, k);
+    double xnorm = 0.0;
+    for (int i = k + 2; i < n; i++) {
+      xnorm += a(i, k) * a(i, k);
+    }
+    xnorm = std::sqrt(xnorm);
+    if (xnorm == 0.0) {
+      e[k] = alpha;
+      continue;
+    }
+    double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+    double scale = 1.0 / (alpha - beta);
+    tau[k] = (beta - alpha) / beta;
+    v[k + 1] = 1.0;
+    for (int i = k + 2; i < n; i++) {
+      a(i, k) *= scale;
+      v[i] = a(i, k);
+    }
+    e[k] = beta;
+    // A22 -= v * w^T + w * v^T, где w = p - (tau / 2) * (p^T v) * v,
+    // p = tau * A22 * v
+    double pv = 0.0;
+    for (int i = k + 1; i < n; i++) {
+      double sum = 0.0;
+      for (int j = k + 1; j < n; j++) {
+        sum += a(i, j) * v[j];
+      }
+      w[i] = tau[k] * sum;
+      pv += w[i] * v[i];
+    }
+    double half = 0.5 * tau[k] * pv;
+    for (int i = k + 1; i < n; i++) {
+      w[i] -= half * v[i];
+    }
+    for (int i = k + 1; i < n; i++) {
+      for (int j = k + 1; j < n; j++) {
+        a(i, j) -= v[i] * w[j] + w[i] * v[j];
+      }
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    d[i] = a(i, i);
+  }
+  if (n >= 2) {
+    e[n - 2] = a(n - 1, n - 2);
+  }
+}
+
+// Применяет Q = H_0 * H_1 * ... к вектору x
+void ApplyQ(const Dense &a, const std::vector<double> &tau, double *x) {
+  int n = a.n;
+  for (int k = n - 3; k >= 0; k--) {
+    if (tau[k] == 0.0) {
+      continue;
+    }
+    double w = x[k + 1];
+    for (int i = k + 2; i < n; i++) {
+      w += a(i, k) * x[i];
+    }
+    w *= tau[k];
+    x[k + 1] -= w;
+    for (int i = k + 2; i < n; i++) {
+      x[i] -= w * a(i, k);
+    }
+  }
+}
+
+// Неявный QL-алгоритм со сдвигами для трехдиагональной матрицы. Если z не
+// nullptr, вращения накапливаются в его столбцах
+// @throw std::runtime_error значение не сошлось за kQLMaxIterations
+void TridiagonalQL(std::vector<double> &d, std::vector<double> &e, Dense *z) {
+  int n = static_cast<int>(d.size());
+  double f = 0.0;
+  double tst1 = 0.0;
+  for (int l = 0; l < n; l++) {
+    tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+    // Сравнения записаны так, что NaN считается несошедшимся: такое
+    // значение исчерпает kQLMaxIterations, а не вернется молча
+    int m = l;
+    while (m < n - 1 && !(std::abs(e[m]) <= kEpsilon * tst1)) {
+      m++;
+    }
+    if (m > l) {
+      int iterations = 0;
+      do {
+        if (++iterations > kQLMaxIterations) {
+          throw std::runtime_error("Eigenvalues did not converge.");
+        }
+        double g = d[l];
+        double p = (d[l + 1] - g) / (2.0 * e[l]);
+        double r = std::copysign(std::hypot(p, 1.0), p);
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        double dl1 = d[l + 1];
+        double h = g - d[l];
+        for (int i = l + 2; i < n; i++) {
+          d[i] -= h;
+        }
+        f += h;
+        p = d[m];
+        double c = 1.0;
+        double c2 = c;
+        double c3 = c;
+        double el1 = e[l + 1];
+        double s = 0.0;
+        double s2 = 0.0;
+        for (int i = m - 1; i >= l; i--) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = std::hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          if (z != nullptr) {
+            for (int k = 0; k < n; k++) {
+              h = (*z)(k, i + 1);
+              (*z)(k, i + 1) = s * (*z)(k, i) + c * h;
+              (*z)(k, i) = c * (*z)(k, i) - s * h;
+            }
+          }
+        }
+        p = -s * s2 * c3 * el1 * e[l] / dl1;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (!(std::abs(e[l]) <= kEpsilon * tst1));
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+}
+
+// Число собственных значений трехдиагональной матрицы, меньших x
+// (последовательность Штурма)
+int CountBelow(const std::vector<double> &d, const std::vector<double> &e,
+               double x) {
+  int count = 0;
+  double q = 1.0;
+  for (size_t i = 0; i < d.size(); i++) {
+    double off = i == 0 ? 0.0 : e[i - 1] * e[i - 1];
+    q = d[i] - x - (i == 0 ? 0.0 : off / q);
+    if (q == 0.0) {
+      q = -kEpsilon * (std::abs(x) + kEpsilon);
+    }
+    if (q < 0.0) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Бисекция для собственного значения с номером index (по возрастанию)
+double Bisection(const std::vector<double> &d, const std::vector<double> &e,
+                 int index, double low, double high) {
+  while (high - low >
+         2.0 * kEpsilon * std::max(std::abs(low), std::abs(high))) {
+    double mid = 0.5 * (low + high);
+    if (mid == low || mid == high) {
+      break;
+    }
+    if (CountBelow(d, e, mid) > index) {
+      high = mid;
+    } else {
+      low = mid;
+    }
+  }
+  return 0.5 * (low + high);
+}
+
+// Обратные итерации для собственного вектора трехдиагональной матрицы.
+// (T - lambda * I) * y = x решается исключением Гаусса с выбором главного
+// элемента, у верхнетреугольного множителя две наддиагонали
+void InverseIteration(const std::vector<double> &d,
+                      const std::vector<double> &e, double lambda,
+                      double norm, const std::vector<std::vector<double>> &prev,
+                      const std::vector<double> &prev_values,
+                      std::vector<double> &x) {
+  int n = static_cast<int>(d.size());
+  double shift = lambda + kEpsilon * norm;
+  std::vector<double> diag(n), up1(n, 0.0), up2(n, 0.0), mult(n, 0.0);
+  std::vector<bool> swapped(n, false);
+  for (int i = 0; i < n; i++) {
+    diag[i] = d[i] - shift;
+    if (i + 1 < n) {
+      up1[i] = e[i];
+    }
+  }
+  std::vector<double> low(e);
+  for (int i = 0; i + 1 < n; i++) {
+    if (std::abs(low[i]) > std::abs(diag[i])) {
+      // Перестановка строк i и i + 1
+      swapped[i] = true;
+      double m = diag[i] / low[i];
+      mult[i] = m;
+      double d_next = diag[i + 1];
+      double u_next = i + 2 < n ? up1[i + 1] : 0.0;
+      diag[i] = low[i];
+      double old_up1 = up1[i];
+      up1[i] = d_next;
+      up2[i] = u_next;
+      diag[i + 1] = old_up1 - m * d_next;
+      if (i + 2 < n) {
+        up1[i + 1] = -m * u_next;
+      }
+    } else {
+      double m = diag[i] == 0.0 ? 0.0 : low[i] / diag[i];
+      mult[i] = m;
+      diag[i + 1] -= m * up1[i];
+    }
+    if (diag[i] == 0.0) {
+      diag[i] = kEpsilon * norm;
+    }
+  }
+  if (diag[n - 1] == 0.0) {
+    diag[n - 1] = kEpsilon * norm;
+  }
+  x.assign(n, 1.0 / std::sqrt(static_cast<double>(n)));
+  for (int i = 0; i < n; i++) {
+    x[i] += 1e-3 * std::sin(1.0 + i);
+  }
+  for (int iter = 0; iter < kInverseIterations; iter++) {
+    for (int i = 0; i + 1 < n; i++) {
+      if (swapped[i]) {
+        std::swap(x[i], x[i + 1]);
+        x[i + 1] -= mult[i] * x[i];
+      } else {
+        x[i + 1] -= mult[i] * x[i];
+      }
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      double sum = x[i];
+      if (i + 1 < n) {
+        sum -= up1[i] * x[i + 1];
+      }
+      if (i + 2 < n) {
+        sum -= up2[i] * x[i + 2];
+      }
+      x[i] = sum / diag[i];
+    }
+    // Ортогонализация к уже найденным векторам близких собственных значений
+    for (size_t p = 0; p < prev.size(); p++) {
+      if (std::abs(prev_values[p] - lambda) > 1e-3 * norm) {
+        continue;
+      }
+      double dot = 0.0;
+      for (int i = 0; i < n; i++) {
+        dot += prev[p][i] * x[i];
+      }
+      for (int i = 0; i < n; i++) {
+        x[i] -= dot * prev[p][i];
+      }
+    }
+    double length = 0.0;
+    for (int i = 0; i < n; i++) {
+      length += x[i] * x[i];
+    }
+    length = std::sqrt(length);
+    for (int i = 0; i < n; i++) {
+      x[i] /= length;
+    }
+  }
+}
+
+}  // namespace
+
+S21Matrix S21Matrix::SymmetricEigen(S21Matrix *vectors, int count) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  int n = rows_;
+  if (count < 0 || count > n) {
+    throw std::invalid_argument("Invalid number of eigenvalues.");
+  }
+  if (count == 0) {
+    count = n;
+  }
+  Dense a(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      double aij = matrix_[i][j];
+      double aji = matrix_[j][i];
+      if (std::abs(aij - aji) >
+          kSymmetryTolerance *
+              std::max(1.0, std::max(std::abs(aij), std::abs(aji)))) {
+        throw std::invalid_argument("Matrix is not symmetric.");
+      }
+      a(i, j) = 0.5 * (aij + aji);
+    }
+  }
+
+  S21Matrix values(count, 1);
+  S21Matrix result_vectors(n, count);
+  std::vector<double> eigen;
+  std::vector<int> order(n);
+  if (n <= kJacobiMaxSize || count == n) {
+    // Полный спектр: Якоби для маленьких матриц, иначе трехдиагонализация и
+    // неявный QL
+    Dense z(n);
+    Dense *z_ptr = vectors != nullptr ? &z : nullptr;
+    if (n <= kJacobiMaxSize) {
+      Jacobi(a, eigen, z_ptr);
+    } else {
+      std::vector<double> e, tau;
+      Tridiagonalize(a, eigen, e, tau);
+      for (int i = 0; z_ptr != nullptr && i < n; i++) {
+        z(i, i) = 1.0;
+      }
+      TridiagonalQL(eigen, e, z_ptr);
+      if (z_ptr != nullptr) {
+        std::vector<double> column(n);
+        for (int j = 0; j < n; j++) {
+          for (int i = 0; i < n; i++) {
+            column[i] = z(i, j);
+          }
+          ApplyQ(a, tau, column.data());
+          for (int i = 0; i < n; i++) {
+            z(i, j) = column[i];
+          }
+        }
+      }
+    }
+    for (int i = 0; i < n; i++) {
+      order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&eigen](int l, int r) { return eigen[l] > eigen[r]; });
+    for (int k = 0; k < count; k++) {
+      values.matrix_[k][0] = eigen[order[k]];
+      for (int i = 0; vectors != nullptr && i < n; i++) {
+        result_vectors.matrix_[i][k] = z(i, order[k]);
+      }
+    }
+  } else {
+    // Только старшие count значений: бисекция по последовательности Штурма
+    // и обратные итерации для векторов вместо полного QL
+    std::vector<double> d, e, tau;
+    Tridiagonalize(a, d, e, tau);
+    double low = d[0];
+    double high = d[0];
+    for (int i = 0; i < n; i++) {
+      double radius = (i > 0 ? std::abs(e[i - 1]) : 0.0) +
+                      (i + 1 < n ? std::abs(e[i]) : 0.0);
+      low = std::min(low, d[i] - radius);
+      high = std::max(high, d[i] + radius);
+    }
+    double norm = std::max(std::abs(low), std::abs(high));
+    low -= kEpsilon * norm;
+    high += kEpsilon * norm;
+    std::vector<std::vector<double>> found;
+    std::vector<double> found_values;
+    for (int k = 0; k < count; k++) {
+      double lambda = Bisection(d, e, n - 1 - k, low, high);
+      values.matrix_[k][0] = lambda;
+      if (vectors != nullptr) {
+        std::vector<double> x;
+        InverseIteration(d, e, lambda, norm, found, found_values, x);
+        found.push_back(x);
+        found_values.push_back(lambda);
+        ApplyQ(a, tau, x.data());
+        for (int i = 0; i < n; i++) {
+          result_vectors.matrix_[i][k] = x[i];
+        }
+      }
+    }
+  }
+  if (vectors != nullptr) {
+    *vectors = std::move(result_vectors);
+  }
+  return values;
+}
@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+namespace {
+
+// Размер блока, как у MulInto: три блока помещаются в кэш
+constexpr int kGemmBlock = 64;
+
+using Rows = double *const *;
+using ConstRows = const double *const *;
+
+// c[i] += alpha * a[i] * b для строк [begin, end)
+void GemmNN(ConstRows a, ConstRows b, Rows c, int begin, int end, int depth,
+            int n, double alpha) {
+  for (int i0 = begin; i0 < end; i0 += kGemmBlock) {
+    int i1 = std::min(i0 + kGemmBlock, end);
+    for (int k0 = 0; k0 < depth; k0 += kGemmBlock) {
+      int k1 = std::min(k0 + kGemmBlock, depth);
+      for (int j0 = 0; j0 < n; j0 += kGemmBlock) {
+        int j1 = std::min(j0 + kGemmBlock, n);
+        for (int i = i0; i < i1; i++) {
+          double *out = c[i];
+          for (int k = k0; k < k1; k++) {
+            double factor = alpha * a[i][k];
+            const double *row = b[k];
+            for (int j = j0; j < j1; j++) {
+              out[j] += factor * row[j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// a^T * b: столбец i матрицы a читается по элементу, строки b и c - подряд
+void GemmTN(ConstRows a, ConstRows b, Rows c, int begin, int end, int depth,
+            int n, double alpha) {
+  for (int i0 = begin; i0 < end; i0 += kGemmBlock) {
+    int i1 = std::min(i0 + kGemmBlock, end);
+    for (int k0 = 0; k0 < depth; k0 += kGemmBlock) {
+      int k1 = std::min(k0 + kGemmBlock, depth);
+      for (int j0 = 0; j0 < n; j0 += kGemmBlock) {
+        int j1 = std::min(j0 + kGemmBlock, n);
+        for (int i = i0; i < i1; i++) {
+          double *out = c[i];
+          for (int k = k0; k < k1; k++) {
+            double factor = alpha * a[k][i];
+            const double *row = b[k];
+            for (int j = j0; j < j1; j++) {
+              out[j] += factor * row[j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// a * b^T: каждый элемент - скалярное произведение двух строк
+void GemmNT(ConstRows a, ConstRows b, Rows c, int begin, int end, int depth,
+            int n, double alpha) {
+  for (int i0 = begin; i0 < end; i0 += kGemmBlock) {
+    int i1 = std::min(i0 + kGemmBlock, end);
+    for (int j0 = 0; j0 < n; j0 += kGemmBlock) {
+      int j1 = std::min(j0 + kGemmBlock, n);
+      for (int i = i0; i < i1; i++) {
+        const double *left = a[i];
+        for (int j = j0; j < j1; j++) {
+          const double *right = b[j];
+          double sum = 0.0;
+          for (int k = 0; k < depth; k++) {
+            sum += left[k] * right[k];
+          }
+          c[i][j] += alpha * sum;
+        }
+      }
+    }
+  }
+}
+
+// a^T * b^T = (b * a)^T: блок b * a считается в плитку, которая
+// прибавляется к c транспонированной, пока лежит в кэше
+void GemmTT(ConstRows a, ConstRows b, Rows c, int begin, int end, int depth,
+            int n, double alpha) {
+  std::vector<double> tile(kGemmBlock * kGemmBlock);
+  for (int i0 = begin; i0 < end; i0 += kGemmBlock) {
+    int i1 = std::min(i0 + kGemmBlock, end);
+    for (int j0 = 0; j0 < n; j0 += kGemmBlock) {
+      int j1 = std::min(j0 + kGemmBlock, n);
+      std::fill(tile.begin(), tile.end(), 0.0);
+      for (int k0 = 0; k0 < depth; k0 += kGemmBlock) {
+        int k1 = std::min(k0 + kGemmBlock, depth);
+        for (int j = j0; j < j1; j++) {
+          double *out = tile.data() + (j - j0) * kGemmBlock;
+          for (int k = k0; k < k1; k++) {
+            double factor = b[j][k];
+            const double *row = a[k] + i0;
+            for (int i = 0; i < i1 - i0; i++) {
+              out[i] += factor * row[i];
+            }
+          }
+        }
+      }
+      for (int i = i0; i < i1; i++) {
+        for (int j = j0; j < j1; j++) {
+          c[i][j] += alpha * tile[(j - j0) * kGemmBlock + (i - i0)];
+        }
+      }
+    }
+  }
+}
+
+// Блоки строк треугольника идут парами b и blocks - 1 - b, чтобы части
+// были равны по работе; block получает границы [i0, i1)
+template <typename Block>
+void ForEachTriangleBlock(int n, Block block) {
+  int blocks = (n + kGemmBlock - 1) / kGemmBlock;
+  S21ParallelFor(0, (blocks + 1) / 2, 1, [&](int, int begin, int end) {
+    for (int p = begin; p < end; p++) {
+      block(p * kGemmBlock, std::min(n, (p + 1) * kGemmBlock));
+      int q = blocks - 1 - p;
+      if (q != p) {
+        block(q * kGemmBlock, std::min(n, (q + 1) * kGemmBlock));
+      }
+    }
+  });
+}
+
+}  // namespace
+
+void S21Matrix::Gemm(S21Op op_a, S21Op op_b, double alpha, const S21Matrix &a,
+                     const S21Matrix &b, double beta) {
+  if (alpha != alpha || beta != beta) {
+    throw std::invalid_argument("Incorrect argument for multiplication.");
+  }
+  bool trans_a = op_a == S21Op::kTrans;
+  bool trans_b = op_b == S21Op::kTrans;
+  int m = trans_a ? a.cols_ : a.rows_;
+  int depth = trans_a ? a.rows_ : a.cols_;
+  int n = trans_b ? b.rows_ : b.cols_;
+  if ((trans_b ? b.cols_ : b.rows_) != depth || rows_ != m || cols_ != n) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  // Множитель, совпадающий с this, копируется до записи
+  std::unique_ptr<S21Matrix> a_copy, b_copy;
+  const S21Matrix *left = &a;
+  const S21Matrix *right = &b;
+  if (&a == this) {
+    a_copy = std::make_unique<S21Matrix>(a);
+    left = a_copy.get();
+  }
+  if (&b == this) {
+    b_copy = std::make_unique<S21Matrix>(b);
+    right = b_copy.get();
+  }
+  Invalidate();
+  if (beta != 1.0) {
+    for (int i = 0; i < rows_; i++) {
+      for (int j = 0; j < cols_; j++) {
+        matrix_[i][j] = beta == 0.0 ? 0.0 : matrix_[i][j] * beta;
+      }
+    }
+  }
+  if (alpha == 0.0 || depth == 0) {
+    return;
+  }
+  auto kernel = trans_a ? (trans_b ? GemmTT : GemmTN)
+                        : (trans_b ? GemmNT : GemmNN);
+  ConstRows a_rows = left->matrix_;
+  ConstRows b_rows = right->matrix_;
+  Rows c_rows = matrix_;
+  S21ParallelFor(0, m, kGemmBlock, [&](int, int begin, int end) {
+    kernel(a_rows, b_rows, c_rows, begin, end, depth, n, alpha);
+  });
+}
+
+void S21Matrix::Syrk(S21Op op, double alpha, const S21Matrix &a, double beta,
+                     bool fill_upper) {
+  if (alpha != alpha || beta != beta) {
+    throw std::invalid_argument("Incorrect argument for multiplication.");
+  }
+  bool trans = op == S21Op::kTrans;
+  int n = trans ? a.cols_ : a.rows_;
+  int depth = trans ? a.rows_ : a.cols_;
+  if (rows_ != n || cols_ != n) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  std::unique_ptr<S21Matrix> a_copy;
+  const S21Matrix *source = &a;
+  if (&a == this) {
+    a_copy = std::make_unique<S21Matrix>(a);
+    source = a_copy.get();
+  }
+  Invalidate();
+  ConstRows a_rows = source->matrix_;
+  Rows c_rows = matrix_;
+  ForEachTriangleBlock(n, [&](int i0, int i1) {
+    for (int i = i0; i < i1; i++) {
+      for (int j = 0; j <= i; j++) {
+        c_rows[i][j] = beta == 0.0 ? 0.0 : c_rows[i][j] * beta;
+      }
+    }
+    if (alpha == 0.0) {
+      return;
+    }
+    if (trans) {
+      // Строки [i0, i1) матрицы Грама: панель строк a читается один раз на
+      // блок, как в GemmTN, и остается в кэше для всех его строк
+      for (int k0 = 0; k0 < depth; k0 += kGemmBlock) {
+        int k1 = std::min(k0 + kGemmBlock, depth);
+        for (int j0 = 0; j0 < i1; j0 += kGemmBlock) {
+          for (int i = std::max(i0, j0); i < i1; i++) {
+            double *out = c_rows[i];
+            int j1 = std::min(j0 + kGemmBlock, i + 1);
+            for (int k = k0; k < k1; k++) {
+              double factor = alpha * a_rows[k][i];
+              const double *row = a_rows[k];
+              for (int j = j0; j < j1; j++) {
+                out[j] += factor * row[j];
+              }
+            }
+          }
+        }
+      }
+    } else {
+      for (int j0 = 0; j0 < i1; j0 += kGemmBlock) {
+        for (int i = std::max(i0, j0); i < i1; i++) {
+          const double *left = a_rows[i];
+          int j1 = std::min(j0 + kGemmBlock, i + 1);
+          for (int j = j0; j < j1; j++) {
+            const double *right = a_rows[j];
+            double sum = 0.0;
+            for (int k = 0; k < depth; k++) {
+              sum += left[k] * right[k];
+            }
+            c_rows[i][j] += alpha * sum;
+          }
+        }
+      }
+    }
+  });
+  if (fill_upper) {
+    MirrorLower();
+  }
+}
+
+void S21Matrix::MirrorLower() {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  Invalidate();
+  for (int i = 0; i < rows_; i++) {
+    for (int j = i + 1; j < cols_; j++) {
+      matrix_[i][j] = matrix_[j][i];
+    }
+  }
+}
@@ -0,0 +1,375 @@
+#include "s21_matrix_layout.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+constexpr int kTile = S21LayoutMatrix::kTileSize;
+
+// Чередование битов номера строки и столбца плитки: близкие по кривой
+// Мортона плитки близки и по вертикали, и по горизонтали
+uint64_t MortonCode(uint32_t row, uint32_t col) {
+  uint64_t code = 0;
+  for (int bit = 0; bit < 32; bit++) {
+    code |= static_cast<uint64_t>((row >> bit) & 1u) << (2 * bit + 1);
+    code |= static_cast<uint64_t>((col >> bit) & 1u) << (2 * bit);
+  }
+  return code;
+}
+
+// Вызов f(i, j, значение) для всех элементов, буфер читается по
+// непрерывным отрезкам
+template <typename F>
+void ForEachStored(const S21LayoutMatrix &m, F f) {
+  const double *data = m.Data();
+  int rows = m.GetRows();
+  int cols = m.GetCols();
+  if (m.GetLayout() == S21Layout::kRowMajor) {
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        f(i, j, data[static_cast<size_t>(i) * cols + j]);
+      }
+    }
+  } else if (m.GetLayout() == S21Layout::kColMajor) {
+    for (int j = 0; j < cols; j++) {
+      for (int i = 0; i < rows; i++) {
+        f(i, j, data[static_cast<size_t>(j) * rows + i]);
+      }
+    }
+  } else {
+    for (int i0 = 0; i0 < rows; i0 += kTile) {
+      for (int j0 = 0; j0 < cols; j0 += kTile) {
+        const double *tile = data + m.Offset(i0, j0);
+        int height = std::min(kTile, rows - i0);
+        int width = std::min(kTile, cols - j0);
+        for (int r = 0; r < height; r++) {
+          for (int c = 0; c < width; c++) {
+            f(i0 + r, j0 + c, tile[r * kTile + c]);
+          }
+        }
+      }
+    }
+  }
+}
+
+// Шаг в буфере между соседними элементами строки внутри одной плитки
+size_t ColumnStride(const S21LayoutMatrix &m) {
+  return m.GetLayout() == S21Layout::kColMajor
+             ? static_cast<size_t>(m.GetRows())
+             : 1;
+}
+
+}  // namespace
+
+S21LayoutMatrix::S21LayoutMatrix(int rows, int cols, S21Layout layout) {
+  Init(rows, cols, layout);
+}
+
+S21LayoutMatrix::S21LayoutMatrix(const S21Matrix &matrix, S21Layout layout) {
+  Init(matrix.GetRows(), matrix.GetCols(), layout);
+  for (int i = 0; i < rows_; i++) {
+    const double *row = &matrix(i, 0);
+    if (layout_ == S21Layout::kColMajor) {
+      for (int j = 0; j < cols_; j++) {
+        data_[static_cast<size_t>(j) * rows_ + i] = row[j];
+      }
+    } else {
+      // По строкам и внутри плитки соседние j лежат подряд
+      for (int j0 = 0; j0 < cols_; j0 += kTile) {
+        int j1 = std::min(cols_, j0 + kTile);
+        std::copy(row + j0, row + j1, data_.begin() + Offset(i, j0));
+      }
+    }
+  }
+}
+
+S21LayoutMatrix::S21LayoutMatrix(const double *data, int rows, int cols,
+                                 S21Layout layout) {
+  Init(rows, cols, layout);
+  std::copy(data, data + data_.size(), data_.begin());
+}
+
+void S21LayoutMatrix::Init(int rows, int cols, S21Layout layout) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+  rows_ = rows;
+  cols_ = cols;
+  layout_ = layout;
+  tile_rows_ = (rows + kTile - 1) / kTile;
+  tile_cols_ = (cols + kTile - 1) / kTile;
+  tile_slot_.clear();
+  if (layout == S21Layout::kMortonTiles) {
+    // Места плиток - их ранги по коду Мортона, поэтому буфер плотный даже
+    // для сетки, стороны которой не степени двойки
+    int tiles = tile_rows_ * tile_cols_;
+    std::vector<std::pair<uint64_t, int>> order(tiles);
+    for (int t = 0; t < tiles; t++) {
+      order[t] = {MortonCode(t / tile_cols_, t % tile_cols_), t};
+    }
+    std::sort(order.begin(), order.end());
+    tile_slot_.resize(tiles);
+    for (int slot = 0; slot < tiles; slot++) {
+      tile_slot_[order[slot].second] = slot;
+    }
+  }
+  data_.assign(GetStorageSize(), 0.0);
+}
+
+int S21LayoutMatrix::GetRows() const { return rows_; }
+
+int S21LayoutMatrix::GetCols() const { return cols_; }
+
+S21Layout S21LayoutMatrix::GetLayout() const { return layout_; }
+
+size_t S21LayoutMatrix::Offset(int i, int j) const {
+  if (layout_ == S21Layout::kRowMajor) {
+    return static_cast<size_t>(i) * cols_ + j;
+  }
+  if (layout_ == S21Layout::kColMajor) {
+    return static_cast<size_t>(j) * rows_ + i;
+  }
+  int slot = tile_slot_[(i / kTile) * tile_cols_ + j / kTile];
+  return static_cast<size_t>(slot) * kTile * kTile + (i % kTile) * kTile +
+         j % kTile;
+}
+
+size_t S21LayoutMatrix::GetStorageSize() const {
+  if (layout_ == S21Layout::kMortonTiles) {
+    return static_cast<size_t>(tile_rows_) * tile_cols_ * kTile * kTile;
+  }
+  return static_cast<size_t>(rows_) * cols_;
+}
+
+double *S21LayoutMatrix::Data() { return data_.data(); }
+
+const double *S21LayoutMatrix::Data() const { return data_.data(); }
+
+double &S21LayoutMatrix::operator()(int i, int j) {
+  if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Matrix index is out of range.");
+  }
+  return data_[Offset(i, j)];
+}
+
+double S21LayoutMatrix::operator()(int i, int j) const {
+  if (i < 0 || j < 0 || i >= rows_ || j >= cols_) {
+    throw std::out_of_range("Matrix index is out of range.");
+  }
+  return data_[Offset(i, j)];
+}
+
+S21LayoutMatrix S21LayoutMatrix::Convert(const S21LayoutMatrix &other,
+                                         S21Layout layout) {
+  S21LayoutMatrix result(other.rows_, other.cols_, layout);
+  size_t src_stride = ColumnStride(other);
+  size_t dst_stride = ColumnStride(result);
+  // Блок kTile x kTile совпадает с плиткой, поэтому внутри блока у обоих
+  // буферов постоянный шаг по j
+  for (int i0 = 0; i0 < other.rows_; i0 += kTile) {
+    int i1 = std::min(other.rows_, i0 + kTile);
+    for (int j0 = 0; j0 < other.cols_; j0 += kTile) {
+      int width = std::min(other.cols_ - j0, kTile);
+      for (int i = i0; i < i1; i++) {
+        const double *src = other.data_.data() + other.Offset(i, j0);
+        double *dst = result.data_.data() + result.Offset(i, j0);
+        for (int c = 0; c < width; c++) {
+          dst[c * dst_stride] = src[c * src_stride];
+        }
+      }
+    }
+  }
+  return result;
+}
+
+void S21LayoutMatrix::Relayout(S21Layout layout) {
+  if (layout != layout_) {
+    *this = Convert(*this, layout);
+  }
+}
+
+S21Matrix S21LayoutMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  ForEachStored(*this,
+                [&](int i, int j, double value) { result(i, j) = value; });
+  return result;
+}
+
+void S21LayoutMatrix::CheckSameShape(const S21LayoutMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+}
+
+void S21LayoutMatrix::SumMatrix(const S21LayoutMatrix &other) {
+  CheckSameShape(other);
+  if (other.layout_ != layout_) {
+    SumMatrix(Convert(other, layout_));
+    return;
+  }
+  for (size_t k = 0; k < data_.size(); k++) {
+    data_[k] += other.data_[k];
+  }
+}
+
+void S21LayoutMatrix::SubMatrix(const S21LayoutMatrix &other) {
+  CheckSameShape(other);
+  if (other.layout_ != layout_) {
+    SubMatrix(Convert(other, layout_));
+    return;
+  }
+  for (size_t k = 0; k < data_.size(); k++) {
+    data_[k] -= other.data_[k];
+  }
+}
+
+void S21LayoutMatrix::MulNumber(double num) {
+  if (num != num) {
+    throw std::invalid_argument("Incorrect argument for multiplication.");
+  }
+  for (double &value : data_) {
+    value *= num;
+  }
+}
+
+S21LayoutMatrix S21LayoutMatrix::operator*(
+    const S21LayoutMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  int m = rows_;
+  int n = other.cols_;
+  int depth = cols_;
+  const double *a = data_.data();
+  const double *b = other.data_.data();
+  S21Layout left = layout_;
+  S21Layout right = other.layout_;
+
+  if (left == S21Layout::kMortonTiles || right == S21Layout::kMortonTiles) {
+    // Плитки обоих множителей: каждая плитка результата накапливается из
+    // произведений непрерывных плиток
+    S21LayoutMatrix a_tiles = left == S21Layout::kMortonTiles
+                                  ? *this
+                                  : Convert(*this, S21Layout::kMortonTiles);
+    S21LayoutMatrix b_tiles = right == S21Layout::kMortonTiles
+                                  ? other
+                                  : Convert(other, S21Layout::kMortonTiles);
+    S21LayoutMatrix result(m, n, S21Layout::kMortonTiles);
+    for (int i0 = 0; i0 < m; i0 += kTile) {
+      int height = std::min(kTile, m - i0);
+      for (int j0 = 0; j0 < n; j0 += kTile) {
+        int width = std::min(kTile, n - j0);
+        double *c_tile = result.data_.data() + result.Offset(i0, j0);
+        for (int k0 = 0; k0 < depth; k0 += kTile) {
+          int inner = std::min(kTile, depth - k0);
+          const double *a_tile = a_tiles.data_.data() + a_tiles.Offset(i0, k0);
+          const double *b_tile = b_tiles.data_.data() + b_tiles.Offset(k0, j0);
+          for (int r = 0; r < height; r++) {
+            for (int k = 0; k < inner; k++) {
+              double aik = a_tile[r * kTile + k];
+              for (int c = 0; c < width; c++) {
+                c_tile[r * kTile + c] += aik * b_tile[k * kTile + c];
+              }
+            }
+          }
+        }
+      }
+    }
+    result.Relayout(layout_);
+    return result;
+  }
+
+  if (left == S21Layout::kColMajor && right == S21Layout::kColMajor) {
+    // Столбец j результата - сумма столбцов a с весами из столбца j у b
+    S21LayoutMatrix result(m, n, S21Layout::kColMajor);
+    for (int j = 0; j < n; j++) {
+      double *out = result.data_.data() + static_cast<size_t>(j) * m;
+      const double *weights = b + static_cast<size_t>(j) * depth;
+      for (int k = 0; k < depth; k++) {
+        const double *column = a + static_cast<size_t>(k) * m;
+        for (int i = 0; i < m; i++) {
+          out[i] += weights[k] * column[i];
+        }
+      }
+    }
+    return result;
+  }
+
+  S21LayoutMatrix result(m, n, S21Layout::kRowMajor);
+  double *c = result.data_.data();
+  if (left == S21Layout::kRowMajor && right == S21Layout::kRowMajor) {
+    for (int i = 0; i < m; i++) {
+      double *out = c + static_cast<size_t>(i) * n;
+      for (int k = 0; k < depth; k++) {
+        double aik = a[static_cast<size_t>(i) * depth + k];
+        const double *row = b + static_cast<size_t>(k) * n;
+        for (int j = 0; j < n; j++) {
+          out[j] += aik * row[j];
+        }
+      }
+    }
+  } else if (left == S21Layout::kRowMajor) {
+    // Строка a и столбец b непрерывны: скалярные произведения
+    for (int i = 0; i < m; i++) {
+      const double *row = a + static_cast<size_t>(i) * depth;
+      for (int j = 0; j < n; j++) {
+        const double *column = b + static_cast<size_t>(j) * depth;
+        double sum = 0.0;
+        for (int k = 0; k < depth; k++) {
+          sum += row[k] * column[k];
+        }
+        c[static_cast<size_t>(i) * n + j] = sum;
+      }
+    }
+  } else {
+    // Столбец a и строка b непрерывны: сумма внешних произведений
+    for (int k = 0; k < depth; k++) {
+      const double *column = a + static_cast<size_t>(k) * m;
+      const double *row = b + static_cast<size_t>(k) * n;
+      for (int i = 0; i < m; i++) {
+        double *out = c + static_cast<size_t>(i) * n;
+        for (int j = 0; j < n; j++) {
+          out[j] += column[i] * row[j];
+        }
+      }
+    }
+  }
+  result.Relayout(layout_);
+  return result;
+}
+
+S21LayoutMatrix S21LayoutMatrix::Transpose() const {
+  if (layout_ != S21Layout::kMortonTiles) {
+    S21Layout flipped = layout_ == S21Layout::kRowMajor
+                            ? S21Layout::kColMajor
+                            : S21Layout::kRowMajor;
+    return S21LayoutMatrix(data_.data(), cols_, rows_, flipped);
+  }
+  S21LayoutMatrix result(cols_, rows_, layout_);
+  ForEachStored(*this, [&](int i, int j, double value) {
+    result.data_[result.Offset(j, i)] = value;
+  });
+  return result;
+}
+
+S21Matrix S21LayoutMatrix::RowSums() const {
+  std::vector<double> totals(rows_, 0.0);
+  ForEachStored(*this, [&](int i, int, double value) { totals[i] += value; });
+  S21Matrix result(rows_, 1);
+  for (int i = 0; i < rows_; i++) {
+    result(i, 0) = totals[i];
+  }
+  return result;
+}
+
+S21Matrix S21LayoutMatrix::ColSums() const {
+  S21Matrix result(1, cols_);
+  double *sums = &result(0, 0);
+  ForEachStored(*this, [&](int, int j, double value) { sums[j] += value; });
+  return result;
+}
@@ -0,0 +1,105 @@
+#ifndef SRC_S21_MATRIX_LAYOUT_H_
+#define SRC_S21_MATRIX_LAYOUT_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Порядок элементов в памяти
+enum class S21Layout {
+  kRowMajor,    // по строкам, как у S21Matrix
+  kColMajor,    // по столбцам, как в Fortran
+  kMortonTiles  // плитки kTileSize x kTileSize (внутри по строкам),
+                // сами плитки в порядке кривой Мортона (Z-order)
+};
+
+/// @brief Матрица в одном непрерывном буфере с выбираемым порядком
+/// элементов. Данные можно принимать в том порядке, в котором их записал
+/// источник, а операции выбирают обход, последовательный для порядка обоих
+/// операндов. Relayout меняет порядок блочным копированием за один проход
+class S21LayoutMatrix {
+ public:
+  /// @brief Сторона плитки для kMortonTiles
+  static constexpr int kTileSize = 32;
+
+  /// @brief Нулевая матрица
+  /// @param rows кол-во строк
+  /// @param cols кол-во столбцов
+  /// @param layout порядок элементов
+  S21LayoutMatrix(int rows, int cols, S21Layout layout = S21Layout::kRowMajor);
+
+  /// @brief Копия S21Matrix в заданном порядке
+  S21LayoutMatrix(const S21Matrix &matrix, S21Layout layout);
+
+  /// @brief Копия внешнего буфера, уже записанного в порядке layout
+  /// @param data rows * cols элементов (для kMortonTiles - GetStorageSize())
+  S21LayoutMatrix(const double *data, int rows, int cols, S21Layout layout);
+
+  int GetRows() const;
+  int GetCols() const;
+  S21Layout GetLayout() const;
+
+  /// @brief Позиция элемента (i, j) в буфере
+  size_t Offset(int i, int j) const;
+
+  /// @brief Размер буфера: rows * cols, для плиток - с дополнением
+  /// крайних плиток до полного размера
+  size_t GetStorageSize() const;
+
+  /// @brief Буфер с элементами в порядке GetLayout()
+  double *Data();
+  const double *Data() const;
+
+  double &operator()(int i, int j);
+  double operator()(int i, int j) const;
+
+  /// @brief Перестановка элементов в другой порядок блоками kTileSize, так
+  /// что и чтение, и запись идут по непрерывным отрезкам
+  void Relayout(S21Layout layout);
+
+  /// @brief Копия в S21Matrix
+  S21Matrix ToMatrix() const;
+
+  /// @brief Поэлементные операции. При одинаковом порядке проход по
+  /// буферам линейный, иначе порядок other приводится к порядку this
+  void SumMatrix(const S21LayoutMatrix &other);
+  void SubMatrix(const S21LayoutMatrix &other);
+  void MulNumber(double num);
+
+  /// @brief Произведение this * other, результат в порядке this. Обход
+  /// выбирается по паре порядков: строки x строки - i-k-j, столбцы x
+  /// столбцы - j-k-i, строки x столбцы - скалярные произведения, столбцы x
+  /// строки - внешние произведения, плитки - умножение плиток
+  S21LayoutMatrix operator*(const S21LayoutMatrix &other) const;
+
+  /// @brief Транспонирование. Для строк и столбцов буфер копируется как
+  /// есть и меняется только порядок: транспонированная матрица по строкам -
+  /// это исходная по столбцам, поэтому результат хранится в другом порядке.
+  /// Плитки остаются плитками
+  S21LayoutMatrix Transpose() const;
+
+  /// @brief Суммы строк (rows x 1) и столбцов (1 x cols) с обходом в
+  /// порядке хранения
+  S21Matrix RowSums() const;
+  S21Matrix ColSums() const;
+
+ private:
+  int rows_;
+  int cols_;
+  S21Layout layout_;
+  int tile_rows_;  // кол-во плиток по вертикали
+  int tile_cols_;  // кол-во плиток по горизонтали
+  /// @brief Номер места плитки (ti, tj) в буфере, ti * tile_cols_ + tj
+  std::vector<int> tile_slot_;
+  std::vector<double> data_;
+
+  void Init(int rows, int cols, S21Layout layout);
+  void CheckSameShape(const S21LayoutMatrix &other) const;
+
+  /// @brief Копия other в порядке layout
+  static S21LayoutMatrix Convert(const S21LayoutMatrix &other,
+                                 S21Layout layout);
+};
+
+#endif  // SRC_S21_MATRIX_LAYOUT_H_
@@ -1,13 +1,112 @@
 #include "s21_matrix_oop.h"
 
+#include <atomic>
 #include <iostream>
-void S21Matrix::NewMatrix() {
-  matrix_ = new double *[rows_]();
+#include <new>
+
+#include "s21_numa.h"
+
+namespace {
+
+// Размер блока при умножении матриц, три блока помещаются в кэш L1/L2
+constexpr int kMulBlock = 64;
+// С этой степени симметричная матрица возводится через спектральное
+// разложение: одно разложение дешевле 2 * log2(k) умножений
+constexpr long long kPowerEigenThreshold = 256;
+
+}  // namespace
+
+struct S21Matrix::DerivedCache {
+  // Биты valid: какие из значений ниже соответствуют текущей матрице
+  enum : unsigned {
+    kDeterminant = 1u << 0,
+    kTranspose = 1u << 1,
+    kComplements = 1u << 2,
+    kInverse = 1u << 3,
+  };
+  unsigned valid = 0;
+  double determinant = 0.0;
+  std::unique_ptr<S21Matrix> transpose;
+  std::unique_ptr<S21Matrix> complements;
+  std::unique_ptr<S21Matrix> inverse;
+};
+
+struct S21Matrix::SharedStorage {
+  double **rows = nullptr;
+  int count = 0;
+  int cols = 0;
+  // Число матриц над буфером. Уход копии уменьшает его с release, а запись
+  // на месте разрешается после чтения с acquire: чтения ушедшей копии
+  // завершены до нее
+  std::atomic<int> owners{1};
+
+  ~SharedStorage() {
+    if (rows != nullptr) {
+      FreeRows(rows, count, cols);
+    }
+  }
+};
+
+double **S21Matrix::AllocateRows(int rows, int cols) {
+  double *data = S21NumaAllocate(rows, cols);
+  double **table = new (std::nothrow) double *[rows];
+  if (table == nullptr) {
+    S21NumaFree(data, rows, cols);
+    throw std::bad_alloc();
+  }
+  for (int i = 0; i < rows; i++) {
+    table[i] = data + static_cast<size_t>(i) * cols;
+  }
+  return table;
+}
+
+void S21Matrix::FreeRows(double **matrix, int rows, int cols) {
+  S21NumaFree(matrix[0], rows, cols);
+  delete[] matrix;
+}
+
+void S21Matrix::NewMatrix() { matrix_ = AllocateRows(rows_, cols_); }
+void S21Matrix::ResetCache() {
+  if (cache_ != nullptr) {
+    cache_->valid = 0;
+  }
+}
+void S21Matrix::Invalidate() {
+  ResetCache();
+  Detach();
+  // Ссылки из operator() этим вызовом становятся недействительными
+  leaked_ = false;
+}
+void S21Matrix::Share() {
+  if (storage_ == nullptr) {
+    storage_ = new SharedStorage();
+    storage_->rows = matrix_;
+    storage_->count = rows_;
+    storage_->cols = cols_;
+  }
+}
+void S21Matrix::Detach() {
+  if (!IsShared()) {
+    return;
+  }
+  double **shared = matrix_;
+  NewMatrix();
   for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_]();
+    std::copy(shared[i], shared[i] + cols_, matrix_[i]);
+  }
+  // Старый буфер остается у остальных копий
+  ReleaseStorage();
+  Share();
+}
+void S21Matrix::ReleaseStorage() {
+  if (storage_ != nullptr &&
+      storage_->owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete storage_;
   }
+  storage_ = nullptr;
 }
 void S21Matrix::SetZero() {
+  Invalidate();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] = 0;
@@ -15,11 +114,11 @@ void S21Matrix::SetZero() {
   }
 }
 void S21Matrix::DeleteMatrix() {
-  if (matrix_ != nullptr) {
-    for (int i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
-    }
-    delete[] matrix_;
+  if (storage_ != nullptr) {
+    ReleaseStorage();
+    matrix_ = nullptr;
+  } else if (matrix_ != nullptr) {
+    FreeRows(matrix_, rows_, cols_);
     matrix_ = nullptr;
   }
 }
@@ -43,26 +142,68 @@ S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
 
 S21Matrix::S21Matrix(const S21Matrix &other)
     : rows_(other.rows_), cols_(other.cols_), matrix_(nullptr) {
+  if (other.cache_ != nullptr) {
+    cache_ = std::make_unique<DerivedCache>();
+  }
+  // Буфер, в который выдана изменяемая ссылка, не делится: запись через
+  // нее изменила бы и копию
+  if (other.storage_ != nullptr && !other.leaked_) {
+    storage_ = other.storage_;
+    storage_->owners.fetch_add(1, std::memory_order_relaxed);
+    matrix_ = other.matrix_;
+    return;
+  }
   NewMatrix();
   // копируем элементы из other матрицы в текущую
   for (int i = 0; i < rows_; i++) {
     std::copy(other.matrix_[i], other.matrix_[i] + cols_, matrix_[i]);
   }
+  if (other.storage_ != nullptr) {
+    Share();
+  }
 }
 
 S21Matrix::S21Matrix(S21Matrix &&other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_),
+      cache_(std::move(other.cache_)),
+      storage_(other.storage_),
+      leaked_(other.leaked_) {
+  other.storage_ = nullptr;
   other.rows_ = 0;
   other.cols_ = 0;
   other.matrix_ = nullptr;
 }
 
-S21Matrix::~S21Matrix() {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+S21Matrix::~S21Matrix() { DeleteMatrix(); }
+
+void S21Matrix::SetCaching(bool enable) {
+  if (!enable) {
+    cache_.reset();
+  } else if (cache_ == nullptr) {
+    cache_ = std::make_unique<DerivedCache>();
   }
-  delete[] matrix_;
-  matrix_ = nullptr;
+}
+
+bool S21Matrix::IsCaching() const { return cache_ != nullptr; }
+
+void S21Matrix::SetSharing(bool enable) {
+  if (enable) {
+    Share();
+  } else if (storage_ != nullptr) {
+    Detach();
+    // Буфер теперь только у этой матрицы, владение им возвращается ей
+    storage_->rows = nullptr;
+    ReleaseStorage();
+  }
+}
+
+bool S21Matrix::IsSharing() const { return storage_ != nullptr; }
+
+bool S21Matrix::IsShared() const {
+  return storage_ != nullptr &&
+         storage_->owners.load(std::memory_order_acquire) > 1;
 }
 
 int S21Matrix::GetRows() const { return rows_; }
@@ -83,13 +224,10 @@ void S21Matrix::SetCols(int cols) {
   if (cols == cols_) {
     return;
   } else {
-    double **new_matrix = new double *[rows_]();
-    for (int i = 0; i < rows_; i++) {
-      new_matrix[i] = new double[cols]();
-      for (int j = 0; j < cols; j++) {
-        new_matrix[i][j] = 0.0;  // Инициализируем нулями
-      }
-    }
+    // Буфер все равно заменяется: общий буфер не отделяется копией, а только
+    // отпускается в DeleteMatrix
+    ResetCache();
+    double **new_matrix = AllocateRows(rows_, cols);  // Заполнена нулями
     // Копируем элементы матрицы
     int new_cols = std::min(cols, cols_);
     for (int i = 0; i < rows_; i++) {
@@ -97,9 +235,14 @@ void S21Matrix::SetCols(int cols) {
         new_matrix[i][j] = matrix_[i][j];
       }
     }
+    bool sharing = storage_ != nullptr;
     DeleteMatrix();
     matrix_ = new_matrix;
+    leaked_ = false;
     cols_ = cols;
+    if (sharing) {
+      Share();
+    }
   }
 }
 
@@ -110,13 +253,10 @@ void S21Matrix::SetRows(int rows) {
   if (rows == rows_) {
     return;
   } else {
-    double **new_matrix = new double *[rows]();
-    for (int i = 0; i < rows; i++) {
-      new_matrix[i] = new double[cols_]();
-      for (int j = 0; j < cols_; j++) {
-        new_matrix[i][j] = 0.0;  // Инициализируем нулями
-      }
-    }
+    // Буфер все равно заменяется: общий буфер не отделяется копией, а только
+    // отпускается в DeleteMatrix
+    ResetCache();
+    double **new_matrix = AllocateRows(rows, cols_);  // Заполнена нулями
     // Копируем элементы матрицы
     int new_rows = std::min(rows, rows_);
     for (int i = 0; i < new_rows; i++) {
@@ -124,9 +264,14 @@ void S21Matrix::SetRows(int rows) {
         new_matrix[i][j] = matrix_[i][j];
       }
     }
+    bool sharing = storage_ != nullptr;
     DeleteMatrix();
     matrix_ = new_matrix;
+    leaked_ = false;
     rows_ = rows;
+    if (sharing) {
+      Share();
+    }
   }
 }
 
@@ -134,6 +279,7 @@ void S21Matrix::SetElement(int rows, int cols, double value) {
   if (rows < 0 || rows >= rows_ || cols < 0 || cols >= cols_) {
     throw std::out_of_range("Invalid row or column index.");
   }
+  Invalidate();
   matrix_[rows][cols] = value;
 }
 
@@ -164,6 +310,9 @@ double &S21Matrix::operator()(int i, int j) {
   if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
     throw std::out_of_range("Matrix index is out of range.");
   }
+  // Через ссылку матрица может быть изменена
+  Invalidate();
+  leaked_ = true;
   return matrix_[i][j];
 }
 
@@ -176,12 +325,20 @@ const double &S21Matrix::operator()(int i, int j) const {
 
 S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
   if (this != &other) {
+    bool sharing = storage_ != nullptr;
     S21Matrix matrix_tmp(other);  // Создаем временный объект
 
     // поменять поля матрицы местами
     std::swap(matrix_, matrix_tmp.matrix_);
+    std::swap(storage_, matrix_tmp.storage_);
     std::swap(rows_, matrix_tmp.rows_);
     std::swap(cols_, matrix_tmp.cols_);
+    leaked_ = false;
+    // Режим разделения сохраняется и при копировании обычной матрицы
+    if (sharing) {
+      Share();
+    }
+    ResetCache();
   }
   return *this;
 }
@@ -189,11 +346,26 @@ S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
 S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
   if (this != &other) {
     // Очистить текущее содержимое
+    bool sharing = storage_ != nullptr;
     DeleteMatrix();
 
     rows_ = other.rows_;
     cols_ = other.cols_;
     matrix_ = other.matrix_;
+    storage_ = other.storage_;
+    other.storage_ = nullptr;
+    leaked_ = other.leaked_;
+    if (sharing) {
+      Share();
+    }
+    // Режим кэша сохраняется, как при копирующем присваивании. Если кэш есть
+    // у обеих матриц, значения other соответствуют перенесенным данным
+    if (cache_ != nullptr && other.cache_ != nullptr) {
+      cache_ = std::move(other.cache_);
+    } else {
+      ResetCache();
+    }
+    other.cache_.reset();
 
     // Зануляем, чтобы предотвратить двойное удаление
     other.rows_ = 0;
@@ -208,6 +380,7 @@ void S21Matrix::SumMatrix(const S21Matrix &other) {
     throw std::invalid_argument(
         "Matrix dimensions are incompatible for addition.");
   }
+  Invalidate();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] = matrix_[i][j] + other.matrix_[i][j];
@@ -226,6 +399,7 @@ void S21Matrix::SubMatrix(const S21Matrix &other) {
     throw std::invalid_argument(
         "Matrix dimensions are incompatible for addition.");
   }
+  Invalidate();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] = matrix_[i][j] - other.matrix_[i][j];
@@ -243,6 +417,7 @@ void S21Matrix::MulNumber(const double num) {
   if (num != num) {
     throw std::invalid_argument("Incorrect argument for multiplication.");
   }
+  Invalidate();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] = matrix_[i][j] * num;
@@ -260,26 +435,47 @@ S21Matrix S21Matrix::operator*(double num) const {
   return result;
 }
 
+void S21Matrix::MulInto(const S21Matrix &a, const S21Matrix &b,
+                        S21Matrix &dst) {
+  dst.SetZero();
+  for (int i0 = 0; i0 < a.rows_; i0 += kMulBlock) {
+    int i1 = std::min(i0 + kMulBlock, a.rows_);
+    for (int k0 = 0; k0 < a.cols_; k0 += kMulBlock) {
+      int k1 = std::min(k0 + kMulBlock, a.cols_);
+      for (int j0 = 0; j0 < b.cols_; j0 += kMulBlock) {
+        int j1 = std::min(j0 + kMulBlock, b.cols_);
+        for (int i = i0; i < i1; i++) {
+          double *out = dst.matrix_[i];
+          for (int k = k0; k < k1; k++) {
+            double aik = a.matrix_[i][k];
+            const double *row = b.matrix_[k];
+            for (int j = j0; j < j1; j++) {
+              out[j] += aik * row[j];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 void S21Matrix::MulMatrix(const S21Matrix &other) {
   if (cols_ != other.rows_) {
     throw std::invalid_argument(
         "Matrix dimensions are incompatible for multiplication.");
   }
-  S21Matrix result;
-  result.SetZero();
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      for (int k = 0; k < cols_; k++) {
-        result(i, j) += matrix_[i][k] * other(k, j);
-      }
-    }
-  }
-  *this = result;
+  S21Matrix result(rows_, other.cols_);
+  MulInto(*this, other, result);
+  *this = std::move(result);
 }
 
 S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
-  S21Matrix result(*this);
-  result.MulMatrix(other);
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  S21Matrix result(rows_, other.cols_);
+  MulInto(*this, other, result);
   return result;
 }
 
@@ -299,11 +495,11 @@ S21Matrix &S21Matrix::operator*=(const double num) {
 }
 
 S21Matrix &S21Matrix::operator*=(const S21Matrix &other) {
-  *this = *this * other;
+  MulMatrix(other);
   return *this;
 }
 
-S21Matrix S21Matrix::Transpose() const {
+S21Matrix S21Matrix::ComputeTranspose() const {
   S21Matrix result(cols_, rows_);
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
@@ -335,7 +531,7 @@ S21Matrix S21Matrix::MinorMatrix(int row, int col) const {
   return minor;
 }
 
-double S21Matrix::Determinant() const {
+double S21Matrix::ComputeDeterminant() const {
   if (rows_ != cols_) {
     throw std::logic_error("The matrix is ​​not square.");
   }
@@ -357,7 +553,7 @@ double S21Matrix::Determinant() const {
   }
 }
 
-S21Matrix S21Matrix::CalcComplements() const {
+S21Matrix S21Matrix::ComputeComplements() const {
   S21Matrix result(rows_, cols_);
   if (rows_ != cols_) {
     throw std::logic_error("The matrix is ​​not square.");
@@ -383,7 +579,7 @@ S21Matrix S21Matrix::CalcComplements() const {
   return result;
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
+S21Matrix S21Matrix::ComputeInverse() const {
   if (rows_ != cols_) {
     throw std::logic_error("The matrix is ​​not square.");
   }
@@ -397,4 +593,141 @@ S21Matrix S21Matrix::InverseMatrix() const {
   result.MulNumber(scalar);
 
   return result;
-}
\ No newline at end of file
+}
+
+S21Matrix S21Matrix::Transpose() const {
+  if (cache_ == nullptr) {
+    return ComputeTranspose();
+  }
+  // Запомненная матрица всегда хранится в режиме разделения: ответ делит с
+  // ней буфер за O(1) и копирует его только при первой записи
+  if (!(cache_->valid & DerivedCache::kTranspose)) {
+    cache_->transpose = std::make_unique<S21Matrix>(ComputeTranspose());
+    cache_->transpose->Share();
+    cache_->valid |= DerivedCache::kTranspose;
+  }
+  return *cache_->transpose;
+}
+
+double S21Matrix::Determinant() const {
+  if (cache_ == nullptr) {
+    return ComputeDeterminant();
+  }
+  if (!(cache_->valid & DerivedCache::kDeterminant)) {
+    cache_->determinant = ComputeDeterminant();
+    cache_->valid |= DerivedCache::kDeterminant;
+  }
+  return cache_->determinant;
+}
+
+S21Matrix S21Matrix::CalcComplements() const {
+  if (cache_ == nullptr) {
+    return ComputeComplements();
+  }
+  if (!(cache_->valid & DerivedCache::kComplements)) {
+    cache_->complements = std::make_unique<S21Matrix>(ComputeComplements());
+    cache_->complements->Share();
+    cache_->valid |= DerivedCache::kComplements;
+  }
+  return *cache_->complements;
+}
+
+S21Matrix S21Matrix::InverseMatrix() const {
+  if (cache_ == nullptr) {
+    return ComputeInverse();
+  }
+  if (!(cache_->valid & DerivedCache::kInverse)) {
+    cache_->inverse = std::make_unique<S21Matrix>(ComputeInverse());
+    cache_->inverse->Share();
+    cache_->valid |= DerivedCache::kInverse;
+  }
+  return *cache_->inverse;
+}
+
+bool S21Matrix::IsSymmetric() const {
+  if (rows_ != cols_) {
+    return false;
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = i + 1; j < cols_; j++) {
+      if (matrix_[i][j] != matrix_[j][i]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+S21Matrix S21Matrix::Power(int k) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  long long exponent = k;
+  bool negative = exponent < 0;
+  if (negative) {
+    exponent = -exponent;
+  }
+  S21Matrix result(rows_, cols_);
+  if (exponent == 0) {
+    for (int i = 0; i < rows_; i++) {
+      result.matrix_[i][i] = 1.0;
+    }
+    return result;
+  }
+
+  if (exponent >= kPowerEigenThreshold && IsSymmetric()) {
+    // A^k = V * diag(lambda^k) * V^T
+    S21Matrix vectors;
+    S21Matrix values = SymmetricEigen(&vectors);
+    S21Matrix scaled(vectors);
+    for (int j = 0; j < cols_; j++) {
+      double lambda = values.matrix_[j][0];
+      if (negative && lambda == 0.0) {
+        throw std::logic_error("Determinant equal to zero");
+      }
+      double factor = std::pow(lambda, static_cast<double>(k));
+      for (int i = 0; i < rows_; i++) {
+        scaled.matrix_[i][j] *= factor;
+      }
+    }
+    MulInto(scaled, vectors.Transpose(), result);
+    return result;
+  }
+
+  // Бинарное возведение: base пробегает A, A^2, A^4, ..., а result и
+  // scratch меняются ролями после каждого умножения без новых выделений.
+  // Обратная матрица - решение A * X = I через LU за O(n^3); result пока
+  // нулевая и служит единичной правой частью
+  S21Matrix base(*this);
+  if (negative) {
+    for (int i = 0; i < rows_; i++) {
+      result.matrix_[i][i] = 1.0;
+    }
+    base = Solve(result);
+  }
+  // Указатели на строки переставляются напрямую, поэтому буфер base не
+  // должен быть общим с *this
+  base.SetSharing(false);
+  S21Matrix scratch(rows_, cols_);
+  bool result_set = false;
+  while (exponent > 0) {
+    if (exponent & 1) {
+      if (result_set) {
+        MulInto(result, base, scratch);
+        std::swap(result.matrix_, scratch.matrix_);
+      } else {
+        for (int i = 0; i < rows_; i++) {
+          std::copy(base.matrix_[i], base.matrix_[i] + cols_,
+                    result.matrix_[i]);
+        }
+        result_set = true;
+      }
+    }
+    exponent >>= 1;
+    if (exponent > 0) {
+      MulInto(base, base, scratch);
+      std::swap(base.matrix_, scratch.matrix_);
+    }
+  }
+  return result;
+}
@@ -3,17 +3,66 @@
 
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 
+/// @brief Как используется множитель в Gemm и Syrk
+enum class S21Op {
+  kNoTrans,  // как есть
+  kTrans     // транспонированным, без построения копии
+};
+
 class S21Matrix {
  private:
   int rows_;
   int cols_;
   double **matrix_;
 
+  /// @brief Запомненные производные результаты (определитель, обратная,
+  /// транспонированная матрицы и матрица дополнений)
+  struct DerivedCache;
+
+  /// @brief Кэш производных результатов, nullptr - кэширование выключено
+  mutable std::unique_ptr<DerivedCache> cache_;
+
+  /// @brief Общий буфер строк для копирования при записи
+  struct SharedStorage;
+
+  /// @brief Владелец matrix_ в режиме разделения, nullptr - матрица сама
+  /// владеет строками. Счетчик владельцев ведет сама SharedStorage
+  SharedStorage *storage_ = nullptr;
+
+  /// @brief Неконстантный operator() выдал ссылку в буфер: пока она может
+  /// использоваться, копии получают собственный буфер, а не общий
+  bool leaked_ = false;
+
+  /// @brief Готовит матрицу к изменению: сбрасывает кэш и получает
+  /// собственную копию общего буфера. Вызывается каждым изменяющим методом
+  /// до записи
+  void Invalidate();
+
+  /// @brief Сбрасывает только кэш
+  void ResetCache();
+
+  /// @brief Передает matrix_ во владение storage_ (включает разделение)
+  void Share();
+
+  /// @brief Если буфер используется еще кем-то, копирует его
+  void Detach();
+
+  /// @brief Отпускает storage_, последний владелец освобождает буфер
+  void ReleaseStorage();
+
   /// @brief Выделение памяти под матрицу
   void NewMatrix();
 
+  /// @brief Таблица строк над одним обнуленным буфером, который размещается
+  /// по узлам NUMA согласно S21GetNumaPolicy()
+  static double **AllocateRows(int rows, int cols);
+
+  /// @brief Освобождение таблицы AllocateRows
+  static void FreeRows(double **matrix, int rows, int cols);
+
   /// @brief Освобождение памяти, выделенной под матрицу
   void DeleteMatrix();
 
@@ -26,6 +75,21 @@ class S21Matrix {
   /// @return Минор матрицы
   S21Matrix MinorMatrix(int row, int col) const;
 
+  /// @brief Блочное умножение a * b в заранее выделенную матрицу
+  /// @param a левый множитель
+  /// @param b правый множитель
+  /// @param dst результат (a.rows x b.cols), не должен совпадать с a или b
+  static void MulInto(const S21Matrix &a, const S21Matrix &b, S21Matrix &dst);
+
+  /// @brief Проверка матрицы на симметричность
+  bool IsSymmetric() const;
+
+  /// @brief Вычисления без кэша, вызываются из одноименных публичных методов
+  double ComputeDeterminant() const;
+  S21Matrix ComputeTranspose() const;
+  S21Matrix ComputeComplements() const;
+  S21Matrix ComputeInverse() const;
+
  public:
   /// @brief Базовый конструктор, инициализирующий матрицу некоторой заранее
   /// заданной размерностью (3x3)
@@ -49,6 +113,41 @@ class S21Matrix {
   /// @brief Инициализация матрицы нулями
   void SetZero();
 
+  /// @brief Включает или выключает запоминание Determinant(), InverseMatrix(),
+  /// Transpose() и CalcComplements(). Повторный запрос к неизмененной матрице
+  /// не пересчитывается и отдается за O(1): запомненная матрица хранится в
+  /// режиме разделения, и ответ делит с ней буфер, поэтому он тоже в этом
+  /// режиме (см. SetSharing). Любой изменяющий метод (в том числе неконстантный
+  /// operator()) сбрасывает запомненное. Копия наследует режим, но не значения.
+  /// Константные методы заполняют кэш, поэтому одновременно вызывать их из
+  /// разных потоков для матрицы с кэшем нельзя
+  /// @param enable true - включить, false - выключить и освободить кэш
+  void SetCaching(bool enable);
+
+  /// @brief Включено ли запоминание производных результатов
+  bool IsCaching() const;
+
+  /// @brief Включает или выключает копирование при записи. Копия такой матрицы
+  /// (конструктором, присваиванием, в том числе внутри операторов библиотеки)
+  /// делит с ней буфер за O(1) и тоже работает в этом режиме; первая запись в
+  /// любую из копий (любой изменяющий метод или неконстантный operator())
+  /// копирует буфер только для нее. Счетчик ссылок атомарный, а запись на месте
+  /// начинается только после того, как остальные копии отпустили буфер
+  /// (release/acquire), поэтому копии можно раздавать потокам и читать и
+  /// изменять параллельно. Для чтения без копирования используйте константную
+  /// ссылку. Ссылка из неконстантного operator() действительна до вызова
+  /// другого изменяющего метода; до тех пор копии этой матрицы буфер с ней не
+  /// делят
+  /// @param enable true - включить, false - выключить (буфер копируется,
+  /// если он сейчас общий)
+  void SetSharing(bool enable);
+
+  /// @brief Включено ли копирование при записи
+  bool IsSharing() const;
+
+  /// @brief Делит ли матрица сейчас буфер с другой матрицей
+  bool IsShared() const;
+
   /// @brief Получаем количество строк матрицы
   /// @return кол-во строк матрицы из приватного поля класса
   int GetRows() const;
@@ -90,7 +189,8 @@ class S21Matrix {
   /// @brief Возвращает значение элемента матрицы по индексу
   /// @param i элемент строки
   /// @param j элемент столбца
-  /// @return значение, которое расположено по индексу
+  /// @return значение, которое расположено по индексу. Ссылка
+  /// действительна до вызова другого изменяющего метода
   double &operator()(int i, int j);
 
   /// @brief Возвращает значение элемента матрицы по индексу (константный метод)
@@ -159,6 +259,216 @@ class S21Matrix {
 
   /// @brief Вычисляет обратную матрицу и возвращает ее
   S21Matrix InverseMatrix() const;
+
+  /// @brief QR-разложение отражениями Хаусхолдера (блочный алгоритм в
+  /// компактной WY-форме), работает и для прямоугольных матриц
+  /// @param q матрица с ортонормированными столбцами (rows x min(rows, cols))
+  /// @param r верхнетреугольная матрица (min(rows, cols) x cols)
+  void QRDecomposition(S21Matrix &q, S21Matrix &r) const;
+
+  /// @brief Решение задачи наименьших квадратов min ||a * x - b|| через
+  /// QR-разложение. Высокая матрица обрабатывается блоками строк, поэтому
+  /// дополнительная память не зависит от числа строк. Для широкой матрицы
+  /// возвращается решение с минимальной нормой
+  /// @param a матрица системы (m x n)
+  /// @param b правая часть (m x k)
+  /// @return решение x (n x k)
+  static S21Matrix LeastSquares(const S21Matrix &a, const S21Matrix &b);
+
+  /// @brief Собственные значения и векторы симметричной матрицы. Маленькие
+  /// матрицы (до 16 x 16) считаются в вызывающем потоке методом Якоби с
+  /// порядком "круговой турнир", большие - трехдиагонализацией и неявным
+  /// QL-алгоритмом. Если нужны не все значения, старшие находятся
+  /// бисекцией, а их векторы - обратными итерациями
+  /// @throw std::runtime_error QL-алгоритм не сошелся (например, из-за NaN)
+  /// @param vectors если не nullptr, сюда записываются собственные векторы по
+  /// столбцам (rows x count)
+  /// @param count сколько наибольших собственных значений вычислить (0 - все)
+  /// @return столбец собственных значений по убыванию (count x 1)
+  S21Matrix SymmetricEigen(S21Matrix *vectors = nullptr, int count = 0) const;
+
+  /// @brief Возведение матрицы в целую степень бинарным возведением: O(log k)
+  /// умножений в буферы, выделенные один раз. Отрицательная степень считается
+  /// через обратную матрицу из LU-разложения (Solve), большая степень
+  /// симметричной матрицы - через спектральное разложение
+  /// @throw std::logic_error матрица не квадратная или вырожденная при k < 0
+  /// @param k показатель степени
+  /// @return матрица в степени k
+  S21Matrix Power(int k) const;
+
+  /// @brief Решение системы a * x = b со смешанной точностью: LU-разложение
+  /// делается над float-копией матрицы, затем решение уточняется итерациями
+  /// с невязкой в double до полной двойной точности. Если уточнение не
+  /// сходится (плохо обусловленная матрица или выход за диапазон float),
+  /// система решается LU-разложением в double
+  /// @param b правая часть (rows x k)
+  /// @param refinements если не nullptr, сюда записывается число шагов
+  /// уточнения или -1, если пришлось решать в double
+  /// @return решение x (rows x k)
+  S21Matrix Solve(const S21Matrix &b, int *refinements = nullptr) const;
+
+  /// @brief Умножение в стиле BLAS: this = alpha * op(a) * op(b) + beta *
+  /// this, на месте и без промежуточных матриц. Транспонирование задается
+  /// порядком обхода, а не копией множителя. При beta == 0 прежнее
+  /// содержимое не читается
+  /// @param op_a как использовать a
+  /// @param op_b как использовать b
+  /// @throw std::invalid_argument размеры this, op(a), op(b) не согласованы
+  /// или alpha, beta - NaN
+  void Gemm(S21Op op_a, S21Op op_b, double alpha, const S21Matrix &a,
+            const S21Matrix &b, double beta);
+
+  /// @brief Симметричное произведение в стиле SYRK: нижний треугольник
+  /// this = alpha * a^T * a + beta * this (op = kTrans, матрица Грама) или
+  /// alpha * a * a^T + beta * this (kNoTrans). Считается только треугольник,
+  /// то есть половина умножений. Для высокой a, читаемой блоками строк,
+  /// вызывайте Syrk(kTrans, 1, блок, 1, false) на каждый блок и MirrorLower в
+  /// конце
+  /// @param fill_upper скопировать результат в верхний треугольник; иначе
+  /// верхний треугольник не меняется
+  /// @throw std::invalid_argument this не квадратная нужного размера или
+  /// alpha, beta - NaN
+  void Syrk(S21Op op, double alpha, const S21Matrix &a, double beta,
+            bool fill_upper = true);
+
+  /// @brief Копирует нижний треугольник квадратной матрицы в верхний
+  /// @throw std::logic_error матрица не квадратная
+  void MirrorLower();
+
+  /// @brief Сумма всех элементов. Суммирование попарное по блокам, поэтому
+  /// погрешность растет как log(n), а не как n; большие матрицы делятся между
+  /// потоками
+  double Sum() const;
+
+  /// @brief След квадратной матрицы
+  double Trace() const;
+
+  /// @brief Норма Фробениуса (корень из суммы квадратов элементов)
+  double NormFrobenius() const;
+
+  /// @brief 1-норма: максимальная сумма модулей по столбцам
+  double Norm1() const;
+
+  /// @brief inf-норма: максимальная сумма модулей по строкам
+  double NormInf() const;
+
+  /// @brief Минимальный элемент матрицы
+  double Min() const;
+
+  /// @brief Максимальный элемент матрицы
+  double Max() const;
+
+  /// @brief Суммы строк (rows x 1)
+  S21Matrix RowSums() const;
+
+  /// @brief Суммы столбцов (1 x cols)
+  S21Matrix ColSums() const;
+
+  /// @brief Свертка каждой строки: acc = op(acc, элемент)
+  /// @param op функция (double, double) -> double
+  /// @param init начальное значение
+  /// @return столбец результатов (rows x 1)
+  template <typename F>
+  S21Matrix ReduceRows(F op, double init) const;
+
+  /// @brief Свертка каждого столбца: acc = op(acc, элемент)
+  /// @param op функция (double, double) -> double
+  /// @param init начальное значение
+  /// @return строка результатов (1 x cols)
+  template <typename F>
+  S21Matrix ReduceCols(F op, double init) const;
+
+  /// @brief Применяет функцию к каждому элементу на месте
+  /// @param f функция double -> double
+  template <typename F>
+  void Apply(F f);
+
+  /// @brief Новая матрица из значений функции от каждого элемента
+  /// @param f функция double -> double
+  template <typename F>
+  S21Matrix Map(F f) const;
+
+  /// @brief Новая матрица из значений функции от пар соответствующих элементов
+  /// @param other матрица того же размера
+  /// @param f функция (double, double) -> double
+  template <typename F>
+  S21Matrix Zip(const S21Matrix &other, F f) const;
 };
 
+// Шаблонные методы: тело функции встраивается в цикл по строке хранилища,
+// который компилятор может векторизовать
+
+template <typename F>
+S21Matrix S21Matrix::ReduceRows(F op, double init) const {
+  S21Matrix result(rows_, 1);
+  for (int i = 0; i < rows_; i++) {
+    const double *row = matrix_[i];
+    double acc = init;
+    for (int j = 0; j < cols_; j++) {
+      acc = op(acc, row[j]);
+    }
+    result.matrix_[i][0] = acc;
+  }
+  return result;
+}
+
+template <typename F>
+S21Matrix S21Matrix::ReduceCols(F op, double init) const {
+  S21Matrix result(1, cols_);
+  double *acc = result.matrix_[0];
+  for (int j = 0; j < cols_; j++) {
+    acc[j] = init;
+  }
+  // Обход по строкам: соседние столбцы обновляются одним проходом по памяти
+  for (int i = 0; i < rows_; i++) {
+    const double *row = matrix_[i];
+    for (int j = 0; j < cols_; j++) {
+      acc[j] = op(acc[j], row[j]);
+    }
+  }
+  return result;
+}
+
+template <typename F>
+void S21Matrix::Apply(F f) {
+  Invalidate();
+  for (int i = 0; i < rows_; i++) {
+    double *row = matrix_[i];
+    for (int j = 0; j < cols_; j++) {
+      row[j] = f(row[j]);
+    }
+  }
+}
+
+template <typename F>
+S21Matrix S21Matrix::Map(F f) const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const double *in = matrix_[i];
+    double *out = result.matrix_[i];
+    for (int j = 0; j < cols_; j++) {
+      out[j] = f(in[j]);
+    }
+  }
+  return result;
+}
+
+template <typename F>
+S21Matrix S21Matrix::Zip(const S21Matrix &other, F f) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for element-wise operation.");
+  }
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const double *left = matrix_[i];
+    const double *right = other.matrix_[i];
+    double *out = result.matrix_[i];
+    for (int j = 0; j < cols_; j++) {
+      out[j] = f(left[j], right[j]);
+    }
+  }
+  return result;
+}
+
 #endif  // SRC_S21_MATRIX_OOP_H_
\ No newline at end of file
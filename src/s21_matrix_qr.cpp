@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+// Ширина панели блочного алгоритма Хаусхолдера
+constexpr int kQRBlock = 32;
+// Минимальное число строк исходной матрицы, обрабатываемых за один проход
+constexpr int kLeastSquaresPanel = 4096;
+
+// Рабочий буфер в порядке по столбцам: отражения Хаусхолдера работают со
+// столбцами, поэтому так они идут по памяти подряд
+struct ColumnMajor {
+  int rows;
+  int cols;
+  std::vector<double> data;
+
+  ColumnMajor(int r, int c)
+      : rows(r), cols(c), data(static_cast<size_t>(r) * c, 0.0) {}
+
+  double &operator()(int i, int j) {
+    return data[static_cast<size_t>(j) * rows + i];
+  }
+  double operator()(int i, int j) const {
+    return data[static_cast<size_t>(j) * rows + i];
+  }
+  double *Col(int j) { return data.data() + static_cast<size_t>(j) * rows; }
+  const double *Col(int j) const {
+    return data.data() + static_cast<size_t>(j) * rows;
+  }
+};
+
+// Строит отражение для подстолбца a(k:rows, col). Вектор v записывается на
+// место поддиагональных элементов (v_k = 1 подразумевается), на диагональ
+// записывается beta. Возвращает tau: H = I - tau * v * v^T
+double MakeReflector(ColumnMajor &a, int k, int col) {
+  double *x = a.Col(col);
+  double alpha = x[k];
+  double xnorm = 0.0;
+  for (int i = k + 1; i < a.rows; i++) {
+    xnorm += x[i] * x[i];
+  }
+  xnorm = std::sqrt(xnorm);
+  if (xnorm == 0.0) {
+    return 0.0;
+  }
+  double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+  double scale = 1.0 / (alpha - beta);
+  for (int i = k + 1; i < a.rows; i++) {
+    x[i] *= scale;
+  }
+  x[k] = beta;
+  return (beta - alpha) / beta;
+}
+
+// Применяет H = I - tau * v * v^T (v хранится в a(k+1:rows, k)) к столбцу c
+// матрицы b, начиная со строки k
+void ApplyReflector(const ColumnMajor &a, int k, double tau, ColumnMajor &b,
+                    int c) {
+  if (tau == 0.0) {
+    return;
+  }
+  const double *v = a.Col(k);
+  double *y = b.Col(c);
+  double w = y[k];
+  for (int i = k + 1; i < a.rows; i++) {
+    w += v[i] * y[i];
+  }
+  w *= tau;
+  y[k] -= w;
+  for (int i = k + 1; i < a.rows; i++) {
+    y[i] -= w * v[i];
+  }
+}
+
+// Блочное QR-разложение на месте. Панель из kQRBlock столбцов
+// факторизуется по одному столбцу, после чего отражения панели собираются
+// в блочное отражение I - V * T * V^T и применяются к остатку матрицы
+// одним проходом по каждому столбцу
+void HouseholderQR(ColumnMajor &a, std::vector<double> &tau) {
+  int steps = std::min(a.rows, a.cols);
+  tau.assign(steps, 0.0);
+  std::vector<double> t(kQRBlock * kQRBlock);
+  std::vector<double> w(kQRBlock);
+  for (int j0 = 0; j0 < steps; j0 += kQRBlock) {
+    int nb = std::min(kQRBlock, steps - j0);
+    // Факторизация панели
+    for (int j = j0; j < j0 + nb; j++) {
+      tau[j] = MakeReflector(a, j, j);
+      for (int c = j + 1; c < j0 + nb; c++) {
+        ApplyReflector(a, j, tau[j], a, c);
+      }
+    }
+    if (j0 + nb >= a.cols) {
+      continue;
+    }
+    // Треугольный множитель T компактной WY-формы
+    std::fill(t.begin(), t.end(), 0.0);
+    for (int i = 0; i < nb; i++) {
+      const double *vi = a.Col(j0 + i);
+      for (int p = 0; p < i; p++) {
+        const double *vp = a.Col(j0 + p);
+        double dot = vp[j0 + i];
+        for (int r = j0 + i + 1; r < a.rows; r++) {
+          dot += vp[r] * vi[r];
+        }
+        w[p] = -tau[j0 + i] * dot;
+      }
+      for (int p = 0; p < i; p++) {
+        double sum = 0.0;
+        for (int q = p; q < i; q++) {
+          sum += t[p * kQRBlock + q] * w[q];
+        }
+        t[p * kQRBlock + i] = sum;
+      }
+      t[i * kQRBlock + i] = tau[j0 + i];
+    }
+    // Остаток: C = (I - V * T^T * V^T) * C
+    for (int c = j0 + nb; c < a.cols; c++) {
+      double *y = a.Col(c);
+      for (int p = 0; p < nb; p++) {
+        const double *vp = a.Col(j0 + p);
+        double dot = y[j0 + p];
+        for (int r = j0 + p + 1; r < a.rows; r++) {
+          dot += vp[r] * y[r];
+        }
+        w[p] = dot;
+      }
+      for (int p = nb - 1; p >= 0; p--) {
+        double sum = 0.0;
+        for (int q = 0; q <= p; q++) {
+          sum += t[q * kQRBlock + p] * w[q];
+        }
+        w[p] = sum;
+      }
+      for (int p = 0; p < nb; p++) {
+        const double *vp = a.Col(j0 + p);
+        y[j0 + p] -= w[p];
+        for (int r = j0 + p + 1; r < a.rows; r++) {
+          y[r] -= w[p] * vp[r];
+        }
+      }
+    }
+  }
+}
+
+// Проверка ранга по диагонали R
+void CheckFullRank(const ColumnMajor &qr, int steps, int max_dim) {
+  double max_diag = 0.0;
+  for (int i = 0; i < steps; i++) {
+    max_diag = std::max(max_diag, std::abs(qr(i, i)));
+  }
+  double tolerance =
+      max_diag * max_dim * std::numeric_limits<double>::epsilon();
+  for (int i = 0; i < steps; i++) {
+    if (std::abs(qr(i, i)) <= tolerance) {
+      throw std::logic_error("Matrix is rank deficient.");
+    }
+  }
+}
+
+}  // namespace
+
+void S21Matrix::QRDecomposition(S21Matrix &q, S21Matrix &r) const {
+  int steps = std::min(rows_, cols_);
+  ColumnMajor qr(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      qr(i, j) = matrix_[i][j];
+    }
+  }
+  std::vector<double> tau;
+  HouseholderQR(qr, tau);
+
+  S21Matrix r_result(steps, cols_);
+  for (int i = 0; i < steps; i++) {
+    for (int j = i; j < cols_; j++) {
+      r_result.matrix_[i][j] = qr(i, j);
+    }
+  }
+  // Q = H_0 * H_1 * ... * H_{k-1} * I, отражения применяются с конца
+  ColumnMajor basis(rows_, steps);
+  for (int j = 0; j < steps; j++) {
+    basis(j, j) = 1.0;
+  }
+  for (int k = steps - 1; k >= 0; k--) {
+    for (int c = k; c < steps; c++) {
+      ApplyReflector(qr, k, tau[k], basis, c);
+    }
+  }
+  S21Matrix q_result(rows_, steps);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < steps; j++) {
+      q_result.matrix_[i][j] = basis(i, j);
+    }
+  }
+  q = std::move(q_result);
+  r = std::move(r_result);
+}
+
+S21Matrix S21Matrix::LeastSquares(const S21Matrix &a, const S21Matrix &b) {
+  if (a.rows_ != b.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for least squares.");
+  }
+  int m = a.rows_;
+  int n = a.cols_;
+  int nrhs = b.cols_;
+  S21Matrix x(n, nrhs);
+
+  if (m < n) {
+    // Недоопределенная система: a^T = Q * R, x = Q * R^{-T} * b
+    ColumnMajor qr(n, m);
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        qr(j, i) = a.matrix_[i][j];
+      }
+    }
+    std::vector<double> tau;
+    HouseholderQR(qr, tau);
+    CheckFullRank(qr, m, n);
+    ColumnMajor y(n, nrhs);
+    for (int c = 0; c < nrhs; c++) {
+      for (int i = 0; i < m; i++) {
+        double sum = b.matrix_[i][c];
+        for (int p = 0; p < i; p++) {
+          sum -= qr(p, i) * y(p, c);
+        }
+        y(i, c) = sum / qr(i, i);
+      }
+      for (int k = m - 1; k >= 0; k--) {
+        ApplyReflector(qr, k, tau[k], y, c);
+      }
+      for (int i = 0; i < n; i++) {
+        x.matrix_[i][c] = y(i, c);
+      }
+    }
+    return x;
+  }
+
+  // Переопределенная система: строки a поступают блоками, над ними
+  // дописывается R предыдущих блоков, и блок снова приводится к
+  // треугольному виду. Память - O((n + panel) * n) вместо O(m * n)
+  int panel = std::max(kLeastSquaresPanel, n);
+  ColumnMajor r(n, n);
+  ColumnMajor c_top(n, nrhs);
+  std::vector<double> tau;
+  for (int start = 0; start < m; start += panel) {
+    int count = std::min(panel, m - start);
+    int top = start == 0 ? 0 : n;
+    ColumnMajor stacked(top + count, n);
+    ColumnMajor rhs(top + count, nrhs);
+    for (int j = 0; j < n; j++) {
+      for (int i = 0; i < top && i <= j; i++) {
+        stacked(i, j) = r(i, j);
+      }
+    }
+    for (int c = 0; c < nrhs; c++) {
+      for (int i = 0; i < top; i++) {
+        rhs(i, c) = c_top(i, c);
+      }
+    }
+    for (int i = 0; i < count; i++) {
+      for (int j = 0; j < n; j++) {
+        stacked(top + i, j) = a.matrix_[start + i][j];
+      }
+      for (int c = 0; c < nrhs; c++) {
+        rhs(top + i, c) = b.matrix_[start + i][c];
+      }
+    }
+    HouseholderQR(stacked, tau);
+    for (int c = 0; c < nrhs; c++) {
+      for (int k = 0; k < n; k++) {
+        ApplyReflector(stacked, k, tau[k], rhs, c);
+      }
+    }
+    for (int j = 0; j < n; j++) {
+      for (int i = 0; i <= j; i++) {
+        r(i, j) = stacked(i, j);
+      }
+    }
+    for (int c = 0; c < nrhs; c++) {
+      for (int i = 0; i < n; i++) {
+        c_top(i, c) = rhs(i, c);
+      }
+    }
+  }
+  CheckFullRank(r, n, m);
+  // Обратная подстановка R * x = Q^T * b
+  for (int c = 0; c < nrhs; c++) {
+    for (int i = n - 1; i >= 0; i--) {
+      double sum = c_top(i, c);
+      for (int j = i + 1; j < n; j++) {
+        sum -= r(i, j) * x.matrix_[j][c];
+      }
+      x.matrix_[i][c] = sum / r(i, i);
+    }
+  }
+  return x;
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+namespace {
+
+// Длина блока, который суммируется напрямую; длиннее - делится пополам
+constexpr int kPairwiseBlock = 128;
+// Сколько элементов должно приходиться на поток, чтобы его запуск окупился
+constexpr int kParallelElements = 1 << 16;
+
+// Попарная сумма f(x[j]). Внутри блока четыре независимых аккумулятора
+// дают процессору складывать параллельно
+template <typename F>
+double PairwiseSum(const double *x, int n, F f) {
+  if (n <= kPairwiseBlock) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+      s0 += f(x[j]);
+      s1 += f(x[j + 1]);
+      s2 += f(x[j + 2]);
+      s3 += f(x[j + 3]);
+    }
+    for (; j < n; j++) {
+      s0 += f(x[j]);
+    }
+    return (s0 + s1) + (s2 + s3);
+  }
+  int half = n / 2;
+  return PairwiseSum(x, half, f) + PairwiseSum(x + half, n - half, f);
+}
+
+double Identity(double x) { return x; }
+
+// Минимальное число строк на поток для матрицы с cols столбцами
+int RowGrain(int cols) { return std::max(1, kParallelElements / cols); }
+
+// Сумма f по каждой строке: строки делятся между потоками, результат не
+// зависит от их числа
+template <typename F>
+std::vector<double> RowwiseSums(double *const *matrix, int rows, int cols,
+                                F f) {
+  std::vector<double> sums(rows);
+  S21ParallelFor(0, rows, RowGrain(cols), [&](int, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      sums[i] = PairwiseSum(matrix[i], cols, f);
+    }
+  });
+  return sums;
+}
+
+// Сумма f по каждому столбцу. Строки делятся на блоки по kPairwiseBlock с
+// границами, не зависящими от потоков; суммы блоков пишутся каждая в свою
+// ячейку и складываются по порядку, поэтому результат не зависит от числа
+// потоков
+template <typename F>
+std::vector<double> ColumnwiseSums(double *const *matrix, int rows, int cols,
+                                   F f) {
+  int blocks = (rows + kPairwiseBlock - 1) / kPairwiseBlock;
+  std::vector<double> block_sums(static_cast<size_t>(blocks) * cols, 0.0);
+  int grain = std::max(1, RowGrain(cols) / kPairwiseBlock);
+  S21ParallelFor(0, blocks, grain, [&](int, int begin, int end) {
+    for (int b = begin; b < end; b++) {
+      double *block = block_sums.data() + static_cast<size_t>(b) * cols;
+      int i1 = std::min((b + 1) * kPairwiseBlock, rows);
+      for (int i = b * kPairwiseBlock; i < i1; i++) {
+        const double *row = matrix[i];
+        for (int j = 0; j < cols; j++) {
+          block[j] += f(row[j]);
+        }
+      }
+    }
+  });
+  std::vector<double> sums(block_sums.begin(), block_sums.begin() + cols);
+  for (int b = 1; b < blocks; b++) {
+    const double *block = block_sums.data() + static_cast<size_t>(b) * cols;
+    for (int j = 0; j < cols; j++) {
+      sums[j] += block[j];
+    }
+  }
+  return sums;
+}
+
+}  // namespace
+
+double S21Matrix::Sum() const {
+  std::vector<double> rows = RowwiseSums(matrix_, rows_, cols_, Identity);
+  return PairwiseSum(rows.data(), rows_, Identity);
+}
+
+double S21Matrix::Trace() const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  double trace = 0.0;
+  for (int i = 0; i < rows_; i++) {
+    trace += matrix_[i][i];
+  }
+  return trace;
+}
+
+double S21Matrix::NormFrobenius() const {
+  auto square = [](double x) { return x * x; };
+  std::vector<double> rows = RowwiseSums(matrix_, rows_, cols_, square);
+  return std::sqrt(PairwiseSum(rows.data(), rows_, Identity));
+}
+
+double S21Matrix::Norm1() const {
+  auto magnitude = [](double x) { return std::abs(x); };
+  std::vector<double> cols = ColumnwiseSums(matrix_, rows_, cols_, magnitude);
+  return *std::max_element(cols.begin(), cols.end());
+}
+
+double S21Matrix::NormInf() const {
+  auto magnitude = [](double x) { return std::abs(x); };
+  std::vector<double> rows = RowwiseSums(matrix_, rows_, cols_, magnitude);
+  return *std::max_element(rows.begin(), rows.end());
+}
+
+double S21Matrix::Min() const {
+  std::vector<double> rows(rows_);
+  S21ParallelFor(0, rows_, RowGrain(cols_), [&](int, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      rows[i] = *std::min_element(matrix_[i], matrix_[i] + cols_);
+    }
+  });
+  return *std::min_element(rows.begin(), rows.end());
+}
+
+double S21Matrix::Max() const {
+  std::vector<double> rows(rows_);
+  S21ParallelFor(0, rows_, RowGrain(cols_), [&](int, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      rows[i] = *std::max_element(matrix_[i], matrix_[i] + cols_);
+    }
+  });
+  return *std::max_element(rows.begin(), rows.end());
+}
+
+S21Matrix S21Matrix::RowSums() const {
+  std::vector<double> sums = RowwiseSums(matrix_, rows_, cols_, Identity);
+  S21Matrix result(rows_, 1);
+  for (int i = 0; i < rows_; i++) {
+    result.matrix_[i][0] = sums[i];
+  }
+  return result;
+}
+
+S21Matrix S21Matrix::ColSums() const {
+  std::vector<double> sums = ColumnwiseSums(matrix_, rows_, cols_, Identity);
+  S21Matrix result(1, cols_);
+  std::copy(sums.begin(), sums.end(), result.matrix_[0]);
+  return result;
+}
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+namespace {
+
+// Предел шагов уточнения, после него решение пересчитывается в double
+constexpr int kMaxRefinements = 30;
+
+// LU-разложение с выбором главного элемента в точности T. Возвращает false,
+// если матрица вырождена в этой точности или элементы переполнились
+template <typename T>
+bool LUFactor(std::vector<T> &lu, std::vector<int> &pivots, int n) {
+  pivots.resize(n);
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < n; i++) {
+      if (std::abs(lu[static_cast<size_t>(i) * n + k]) >
+          std::abs(lu[static_cast<size_t>(pivot) * n + k])) {
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    T *row_k = lu.data() + static_cast<size_t>(k) * n;
+    if (pivot != k) {
+      std::swap_ranges(row_k, row_k + n,
+                       lu.data() + static_cast<size_t>(pivot) * n);
+    }
+    if (row_k[k] == T(0) || !std::isfinite(row_k[k])) {
+      return false;
+    }
+    for (int i = k + 1; i < n; i++) {
+      T *row_i = lu.data() + static_cast<size_t>(i) * n;
+      T factor = row_i[k] / row_k[k];
+      row_i[k] = factor;
+      for (int j = k + 1; j < n; j++) {
+        row_i[j] -= factor * row_k[j];
+      }
+    }
+  }
+  return true;
+}
+
+// Решает L * U * x = P * rhs в точности T, rhs заменяется решением
+template <typename T>
+void LUSolve(const std::vector<T> &lu, const std::vector<int> &pivots, int n,
+             std::vector<T> &rhs) {
+  for (int k = 0; k < n; k++) {
+    std::swap(rhs[k], rhs[pivots[k]]);
+  }
+  for (int i = 0; i < n; i++) {
+    const T *row = lu.data() + static_cast<size_t>(i) * n;
+    T sum = rhs[i];
+    for (int j = 0; j < i; j++) {
+      sum -= row[j] * rhs[j];
+    }
+    rhs[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const T *row = lu.data() + static_cast<size_t>(i) * n;
+    T sum = rhs[i];
+    for (int j = i + 1; j < n; j++) {
+      sum -= row[j] * rhs[j];
+    }
+    rhs[i] = sum / row[i];
+  }
+}
+
+}  // namespace
+
+S21Matrix S21Matrix::Solve(const S21Matrix &b, int *refinements) const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  if (b.rows_ != rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for solving.");
+  }
+  int n = rows_;
+  double norm = NormInf();
+  // Факторизация во float: вдвое меньше памяти и трафика, чем в double
+  std::vector<float> lu_float(static_cast<size_t>(n) * n);
+  bool fits_float = norm <= std::numeric_limits<float>::max();
+  for (int i = 0; fits_float && i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      lu_float[static_cast<size_t>(i) * n + j] =
+          static_cast<float>(matrix_[i][j]);
+    }
+  }
+  std::vector<int> pivots;
+  bool refined = fits_float && LUFactor(lu_float, pivots, n);
+
+  S21Matrix x(n, b.cols_);
+  int total_steps = 0;
+  double tolerance = norm * std::sqrt(static_cast<double>(n)) *
+                     std::numeric_limits<double>::epsilon();
+  std::vector<float> correction(n);
+  std::vector<double> residual(n);
+  for (int c = 0; refined && c < b.cols_; c++) {
+    for (int i = 0; i < n; i++) {
+      correction[i] = static_cast<float>(b.matrix_[i][c]);
+    }
+    LUSolve(lu_float, pivots, n, correction);
+    for (int i = 0; i < n; i++) {
+      x.matrix_[i][c] = correction[i];
+    }
+    // Итерационное уточнение: невязка считается в double, поправка
+    // находится по float-разложению
+    bool converged = false;
+    for (int step = 0; step <= kMaxRefinements; step++) {
+      double residual_norm = 0.0;
+      double x_norm = 0.0;
+      for (int i = 0; i < n; i++) {
+        const double *row = matrix_[i];
+        double sum = b.matrix_[i][c];
+        for (int j = 0; j < n; j++) {
+          sum -= row[j] * x.matrix_[j][c];
+        }
+        residual[i] = sum;
+        residual_norm = std::max(residual_norm, std::abs(sum));
+        x_norm = std::max(x_norm, std::abs(x.matrix_[i][c]));
+      }
+      if (residual_norm <= x_norm * tolerance) {
+        converged = true;
+        break;
+      }
+      if (step == kMaxRefinements || !std::isfinite(residual_norm)) {
+        break;
+      }
+      for (int i = 0; i < n; i++) {
+        correction[i] = static_cast<float>(residual[i]);
+      }
+      LUSolve(lu_float, pivots, n, correction);
+      for (int i = 0; i < n; i++) {
+        x.matrix_[i][c] += correction[i];
+      }
+      total_steps++;
+    }
+    refined = converged;
+  }
+  if (refined) {
+    if (refinements != nullptr) {
+      *refinements = total_steps;
+    }
+    return x;
+  }
+
+  // Уточнение не сошлось: обычное решение в double
+  std::vector<double> lu(static_cast<size_t>(n) * n);
+  for (int i = 0; i < n; i++) {
+    std::copy(matrix_[i], matrix_[i] + n,
+              lu.data() + static_cast<size_t>(i) * n);
+  }
+  if (!LUFactor(lu, pivots, n)) {
+    throw std::logic_error("Determinant equal to zero");
+  }
+  std::vector<double> column(n);
+  for (int c = 0; c < b.cols_; c++) {
+    for (int i = 0; i < n; i++) {
+      column[i] = b.matrix_[i][c];
+    }
+    LUSolve(lu, pivots, n, column);
+    for (int i = 0; i < n; i++) {
+      x.matrix_[i][c] = column[i];
+    }
+  }
+  if (refinements != nullptr) {
+    *refinements = -1;
+  }
+  return x;
+}
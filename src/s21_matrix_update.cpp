@@ -0,0 +1,267 @@
+#include "s21_matrix_update.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Если знаменатель формулы Шермана-Моррисона 1 + v^T * A^{-1} * u меньше
+// этого значения, обновление теряет точность и выполняется факторизация
+constexpr double kMinDenominator = 1e-8;
+
+}  // namespace
+
+S21UpdatableInverse::S21UpdatableInverse(const S21Matrix &matrix,
+                                         int refactor_interval)
+    : size_(matrix.GetRows()),
+      refactor_interval_(refactor_interval),
+      updates_(0),
+      singular_(false),
+      determinant_(0.0),
+      matrix_(matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  if (refactor_interval <= 0) {
+    throw std::invalid_argument("Invalid refactorization interval.");
+  }
+  Refactorize();
+}
+
+const S21Matrix &S21UpdatableInverse::Matrix() const { return matrix_; }
+
+double S21UpdatableInverse::Determinant() const { return determinant_; }
+
+int S21UpdatableInverse::UpdatesSinceRefactorization() const {
+  return updates_;
+}
+
+S21Matrix S21UpdatableInverse::InverseMatrix() const {
+  if (singular_) {
+    throw std::logic_error("Determinant equal to zero");
+  }
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      result(i, j) = inverse_[static_cast<size_t>(i) * size_ + j];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21UpdatableInverse::Solve(const S21Matrix &b) const {
+  if (b.GetRows() != size_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  if (singular_) {
+    throw std::logic_error("Determinant equal to zero");
+  }
+  S21Matrix x(size_, b.GetCols());
+  std::vector<double> column(size_);
+  for (int c = 0; c < b.GetCols(); c++) {
+    for (int k = 0; k < size_; k++) {
+      column[k] = b(k, c);
+    }
+    for (int i = 0; i < size_; i++) {
+      const double *row = inverse_.data() + static_cast<size_t>(i) * size_;
+      double sum = 0.0;
+      for (int k = 0; k < size_; k++) {
+        sum += row[k] * column[k];
+      }
+      x(i, c) = sum;
+    }
+  }
+  return x;
+}
+
+void S21UpdatableInverse::Refactorize() {
+  int n = size_;
+  std::vector<double> lu(static_cast<size_t>(n) * n);
+  double scale = 0.0;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      lu[static_cast<size_t>(i) * n + j] = matrix_(i, j);
+      scale = std::max(scale, std::abs(matrix_(i, j)));
+    }
+  }
+  double tolerance = n * scale * std::numeric_limits<double>::epsilon();
+  std::vector<int> perm(n);
+  for (int i = 0; i < n; i++) {
+    perm[i] = i;
+  }
+  updates_ = 0;
+  determinant_ = 1.0;
+  singular_ = false;
+  // LU-разложение с выбором главного элемента по столбцу
+  for (int k = 0; k < n; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < n; i++) {
+      if (std::abs(lu[static_cast<size_t>(i) * n + k]) >
+          std::abs(lu[static_cast<size_t>(pivot) * n + k])) {
+        pivot = i;
+      }
+    }
+    double *row_k = lu.data() + static_cast<size_t>(k) * n;
+    if (pivot != k) {
+      std::swap_ranges(row_k, row_k + n,
+                       lu.data() + static_cast<size_t>(pivot) * n);
+      std::swap(perm[k], perm[pivot]);
+      determinant_ = -determinant_;
+    }
+    if (std::abs(row_k[k]) <= tolerance) {
+      singular_ = true;
+      determinant_ = 0.0;
+      inverse_.clear();
+      return;
+    }
+    determinant_ *= row_k[k];
+    for (int i = k + 1; i < n; i++) {
+      double *row_i = lu.data() + static_cast<size_t>(i) * n;
+      double factor = row_i[k] / row_k[k];
+      row_i[k] = factor;
+      for (int j = k + 1; j < n; j++) {
+        row_i[j] -= factor * row_k[j];
+      }
+    }
+  }
+  // Столбцы обратной матрицы: L * U * x = P * e_c
+  inverse_.assign(static_cast<size_t>(n) * n, 0.0);
+  std::vector<double> x(n);
+  for (int c = 0; c < n; c++) {
+    for (int i = 0; i < n; i++) {
+      double sum = perm[i] == c ? 1.0 : 0.0;
+      for (int j = 0; j < i; j++) {
+        sum -= lu[static_cast<size_t>(i) * n + j] * x[j];
+      }
+      x[i] = sum;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      double sum = x[i];
+      for (int j = i + 1; j < n; j++) {
+        sum -= lu[static_cast<size_t>(i) * n + j] * x[j];
+      }
+      x[i] = sum / lu[static_cast<size_t>(i) * n + i];
+    }
+    for (int i = 0; i < n; i++) {
+      inverse_[static_cast<size_t>(i) * n + c] = x[i];
+    }
+  }
+}
+
+void S21UpdatableInverse::ApplyRankOne(const std::vector<double> &u,
+                                       const std::vector<double> &v) {
+  updates_++;
+  if (singular_ || updates_ >= refactor_interval_) {
+    Refactorize();
+    return;
+  }
+  int n = size_;
+  // x = A^{-1} * u, y = v^T * A^{-1}
+  std::vector<double> x(n, 0.0);
+  std::vector<double> y(n, 0.0);
+  for (int i = 0; i < n; i++) {
+    const double *row = inverse_.data() + static_cast<size_t>(i) * n;
+    double sum = 0.0;
+    for (int k = 0; k < n; k++) {
+      sum += row[k] * u[k];
+    }
+    x[i] = sum;
+    if (v[i] != 0.0) {
+      for (int k = 0; k < n; k++) {
+        y[k] += v[i] * row[k];
+      }
+    }
+  }
+  double denominator = 1.0;
+  for (int i = 0; i < n; i++) {
+    denominator += v[i] * x[i];
+  }
+  if (std::abs(denominator) < kMinDenominator) {
+    Refactorize();
+    return;
+  }
+  // Лемма об определителе: det(A + u * v^T) = det(A) * (1 + v^T A^{-1} u)
+  determinant_ *= denominator;
+  for (int i = 0; i < n; i++) {
+    double factor = x[i] / denominator;
+    if (factor == 0.0) {
+      continue;
+    }
+    double *row = inverse_.data() + static_cast<size_t>(i) * n;
+    for (int k = 0; k < n; k++) {
+      row[k] -= factor * y[k];
+    }
+  }
+}
+
+void S21UpdatableInverse::RankOneUpdate(const S21Matrix &u,
+                                        const S21Matrix &v) {
+  if (u.GetRows() != size_ || u.GetCols() != 1 || v.GetRows() != size_ ||
+      v.GetCols() != 1) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for rank one update.");
+  }
+  std::vector<double> u_values(size_);
+  std::vector<double> v_values(size_);
+  for (int i = 0; i < size_; i++) {
+    u_values[i] = u(i, 0);
+    v_values[i] = v(i, 0);
+  }
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      matrix_(i, j) += u_values[i] * v_values[j];
+    }
+  }
+  ApplyRankOne(u_values, v_values);
+}
+
+void S21UpdatableInverse::ReplaceRow(int row, const S21Matrix &values) {
+  if (row < 0 || row >= size_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  if (values.GetRows() != 1 || values.GetCols() != size_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for row replacement.");
+  }
+  // Новая строка: A + e_row * (values - A(row, :))
+  std::vector<double> u(size_, 0.0);
+  std::vector<double> v(size_);
+  u[row] = 1.0;
+  for (int j = 0; j < size_; j++) {
+    v[j] = values(0, j) - matrix_(row, j);
+    matrix_(row, j) = values(0, j);
+  }
+  ApplyRankOne(u, v);
+}
+
+void S21UpdatableInverse::ReplaceColumn(int col, const S21Matrix &values) {
+  if (col < 0 || col >= size_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  if (values.GetRows() != size_ || values.GetCols() != 1) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for column replacement.");
+  }
+  // Новый столбец: A + (values - A(:, col)) * e_col^T
+  std::vector<double> u(size_);
+  std::vector<double> v(size_, 0.0);
+  v[col] = 1.0;
+  for (int i = 0; i < size_; i++) {
+    u[i] = values(i, 0) - matrix_(i, col);
+    matrix_(i, col) = values(i, 0);
+  }
+  ApplyRankOne(u, v);
+}
+
+void S21UpdatableInverse::SetElement(int row, int col, double value) {
+  if (row < 0 || row >= size_ || col < 0 || col >= size_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  std::vector<double> u(size_, 0.0);
+  std::vector<double> v(size_, 0.0);
+  u[row] = 1.0;
+  v[col] = value - matrix_(row, col);
+  matrix_(row, col) = value;
+  ApplyRankOne(u, v);
+}
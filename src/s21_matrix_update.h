@@ -0,0 +1,80 @@
+#ifndef SRC_S21_MATRIX_UPDATE_H_
+#define SRC_S21_MATRIX_UPDATE_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Квадратная матрица с поддерживаемыми обратной матрицей и
+/// определителем. Изменения ранга 1 (строка, столбец, элемент) пересчитываются
+/// за O(n^2) по формуле Шермана-Моррисона и лемме об определителе, каждые
+/// refactor_interval изменений выполняется полная LU-факторизация, чтобы
+/// погрешность не накапливалась
+class S21UpdatableInverse {
+ public:
+  /// @brief Количество изменений между полными факторизациями по умолчанию
+  static constexpr int kDefaultRefactorInterval = 64;
+
+  /// @brief Конструктор, выполняет первую факторизацию
+  /// @param matrix квадратная матрица
+  /// @param refactor_interval через сколько изменений факторизовать заново
+  explicit S21UpdatableInverse(
+      const S21Matrix &matrix,
+      int refactor_interval = kDefaultRefactorInterval);
+
+  /// @brief Текущая матрица
+  const S21Matrix &Matrix() const;
+
+  /// @brief Определитель текущей матрицы за O(1)
+  double Determinant() const;
+
+  /// @brief Обратная к текущей матрице
+  S21Matrix InverseMatrix() const;
+
+  /// @brief Решение системы matrix * x = b за O(n^2)
+  /// @param b правая часть (n x k)
+  /// @return решение x (n x k)
+  S21Matrix Solve(const S21Matrix &b) const;
+
+  /// @brief Изменение ранга 1: matrix += u * v^T
+  /// @param u столбец (n x 1)
+  /// @param v столбец (n x 1)
+  void RankOneUpdate(const S21Matrix &u, const S21Matrix &v);
+
+  /// @brief Замена строки матрицы
+  /// @param row номер строки
+  /// @param values новая строка (1 x n)
+  void ReplaceRow(int row, const S21Matrix &values);
+
+  /// @brief Замена столбца матрицы
+  /// @param col номер столбца
+  /// @param values новый столбец (n x 1)
+  void ReplaceColumn(int col, const S21Matrix &values);
+
+  /// @brief Изменение одного элемента матрицы
+  /// @param row номер строки
+  /// @param col номер столбца
+  /// @param value новое значение
+  void SetElement(int row, int col, double value);
+
+  /// @brief Полная LU-факторизация текущей матрицы за O(n^3)
+  void Refactorize();
+
+  /// @brief Количество изменений после последней факторизации
+  int UpdatesSinceRefactorization() const;
+
+ private:
+  int size_;
+  int refactor_interval_;
+  int updates_;
+  bool singular_;
+  double determinant_;
+  S21Matrix matrix_;
+  std::vector<double> inverse_;  // обратная матрица по строкам
+
+  /// @brief Пересчет обратной и определителя после matrix_ += u * v^T.
+  /// Сама matrix_ к этому моменту уже изменена
+  void ApplyRankOne(const std::vector<double> &u, const std::vector<double> &v);
+};
+
+#endif  // SRC_S21_MATRIX_UPDATE_H_
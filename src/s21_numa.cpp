@@ -0,0 +1,274 @@
+#include "s21_numa.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<int> numa_policy{static_cast<int>(S21NumaPolicy::kDefault)};
+std::atomic<bool> thread_pinning{false};
+
+// Узлы, на которых процессу доступны ядра, и эти ядра
+struct Topology {
+  std::vector<int> nodes;
+  std::vector<std::vector<int>> cpus;
+};
+
+// Список вида "0-3,8,10-11" из sysfs
+std::vector<int> ParseList(const std::string &text) {
+  std::vector<int> values;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t comma = text.find(',', pos);
+    if (comma == std::string::npos) {
+      comma = text.size();
+    }
+    std::string item = text.substr(pos, comma - pos);
+    size_t dash = item.find('-');
+    try {
+      int first = std::stoi(item.substr(0, dash));
+      int last = dash == std::string::npos ? first
+                                           : std::stoi(item.substr(dash + 1));
+      for (int value = first; value <= last; value++) {
+        values.push_back(value);
+      }
+    } catch (const std::exception &) {
+      // Нечитаемый элемент пропускается
+    }
+    pos = comma + 1;
+  }
+  return values;
+}
+
+std::string ReadLine(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+Topology LoadTopology() {
+  Topology topology;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+    return topology;
+  }
+  const std::string root = "/sys/devices/system/node/";
+  for (int node : ParseList(ReadLine(root + "online"))) {
+    std::vector<int> cpus;
+    for (int cpu : ParseList(ReadLine(root + "node" + std::to_string(node) +
+                                      "/cpulist"))) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+        cpus.push_back(cpu);
+      }
+    }
+    if (!cpus.empty()) {
+      topology.nodes.push_back(node);
+      topology.cpus.push_back(std::move(cpus));
+    }
+  }
+  if (topology.nodes.empty()) {
+    // Нет sysfs: один узел из всех доступных ядер
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        cpus.push_back(cpu);
+      }
+    }
+    if (!cpus.empty()) {
+      topology.nodes.push_back(0);
+      topology.cpus.push_back(std::move(cpus));
+    }
+  }
+#endif
+  return topology;
+}
+
+const Topology &GetTopology() {
+  static const Topology topology = LoadTopology();
+  return topology;
+}
+
+#ifdef __linux__
+// Политика размещения для диапазона страниц; ошибка (нет прав, ядро без
+// NUMA) оставляет размещение по умолчанию
+void Bind(void *address, size_t length, int mode,
+          const std::vector<int> &nodes) {
+  constexpr size_t kBits = sizeof(unsigned long) * 8;
+  int max_node = *std::max_element(nodes.begin(), nodes.end());
+  std::vector<unsigned long> mask(max_node / kBits + 1, 0);
+  for (int node : nodes) {
+    mask[node / kBits] |= 1ul << (node % kBits);
+  }
+  syscall(SYS_mbind, address, length, mode, mask.data(),
+          mask.size() * kBits + 1, 0);
+}
+
+// Байтовые границы блока строк узла k из nodes, округленные вниз до
+// страницы; последний блок доходит до конца буфера
+std::pair<size_t, size_t> NodeBlock(int k, int nodes, int rows, int cols) {
+  size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t row_bytes = static_cast<size_t>(cols) * sizeof(double);
+  size_t begin = row_bytes * (static_cast<size_t>(rows) * k / nodes);
+  size_t end = row_bytes * (static_cast<size_t>(rows) * (k + 1) / nodes);
+  begin -= begin % page;
+  end = k + 1 == nodes ? row_bytes * rows : end - end % page;
+  return {begin, end};
+}
+
+// Привязывает текущий поток ко всем доступным ядрам узла с индексом k
+void PinToNode(int k) {
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : GetTopology().cpus[k]) {
+    CPU_SET(cpu, &mask);
+  }
+  sched_setaffinity(0, sizeof(mask), &mask);
+}
+
+void Place(double *data, int rows, int cols) {
+  const Topology &topology = GetTopology();
+  int nodes = static_cast<int>(topology.nodes.size());
+  if (nodes <= 1) {
+    return;
+  }
+  char *base = reinterpret_cast<char *>(data);
+  S21NumaPolicy policy = S21GetNumaPolicy();
+  if (policy == S21NumaPolicy::kFirstTouch) {
+    // Страница размещается на узле потока, который первым ее записал,
+    // поэтому блок k обнуляет поток, привязанный к узлу k
+    std::vector<std::thread> touch;
+    for (int k = 0; k < nodes; k++) {
+      touch.emplace_back([=] {
+        PinToNode(k);
+        std::pair<size_t, size_t> block = NodeBlock(k, nodes, rows, cols);
+        std::memset(base + block.first, 0, block.second - block.first);
+      });
+    }
+    for (std::thread &thread : touch) {
+      thread.join();
+    }
+  } else if (policy == S21NumaPolicy::kInterleave) {
+    Bind(data, static_cast<size_t>(rows) * cols * sizeof(double),
+         MPOL_INTERLEAVE, topology.nodes);
+  } else if (policy == S21NumaPolicy::kBindBlocks) {
+    for (int k = 0; k < nodes; k++) {
+      std::pair<size_t, size_t> block = NodeBlock(k, nodes, rows, cols);
+      if (block.second > block.first) {
+        Bind(base + block.first, block.second - block.first, MPOL_PREFERRED,
+             {topology.nodes[k]});
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace
+
+int S21NumaNodeCount() {
+  return std::max(1, static_cast<int>(GetTopology().nodes.size()));
+}
+
+void S21SetNumaPolicy(S21NumaPolicy policy) {
+  numa_policy.store(static_cast<int>(policy));
+}
+
+S21NumaPolicy S21GetNumaPolicy() {
+  return static_cast<S21NumaPolicy>(numa_policy.load());
+}
+
+void S21SetThreadPinning(bool enable) {
+  // Топология читается до первой привязки, пока маска потока не сужена
+  GetTopology();
+  thread_pinning.store(enable);
+}
+
+bool S21GetThreadPinning() { return thread_pinning.load(); }
+
+double *S21NumaAllocate(int rows, int cols) {
+  size_t count = static_cast<size_t>(rows) * cols;
+#ifdef __linux__
+  // Большой буфер берется прямо у ядра: страницы еще не размещены, и их
+  // расположением можно управлять
+  size_t bytes = count * sizeof(double);
+  if (bytes >= kNumaMinBytes) {
+    void *memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    double *data = static_cast<double *>(memory);
+    Place(data, rows, cols);
+    return data;
+  }
+#endif
+  return new double[count]();
+}
+
+void S21NumaFree(double *data, int rows, int cols) {
+  size_t count = static_cast<size_t>(rows) * cols;
+#ifdef __linux__
+  if (count * sizeof(double) >= kNumaMinBytes) {
+    munmap(data, count * sizeof(double));
+    return;
+  }
+#endif
+  delete[] data;
+}
+
+S21ThreadPin::S21ThreadPin(int part, int parts) : pinned_(false) {
+#ifdef __linux__
+  const Topology &topology = GetTopology();
+  if (!thread_pinning.load() || parts <= 1 || topology.nodes.empty()) {
+    return;
+  }
+  long long nodes = static_cast<long long>(topology.nodes.size());
+  int node = static_cast<int>(part * nodes / parts);
+  // Номер части среди частей того же узла
+  int first = static_cast<int>((node * parts + nodes - 1) / nodes);
+  const std::vector<int> &cpus = topology.cpus[node];
+  int cpu = cpus[(part - first) % cpus.size()];
+  cpu_set_t old_mask;
+  if (sched_getaffinity(0, sizeof(old_mask), &old_mask) != 0) {
+    return;
+  }
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  if (sched_setaffinity(0, sizeof(mask), &mask) == 0) {
+    pinned_ = true;
+    const unsigned char *bytes =
+        reinterpret_cast<const unsigned char *>(&old_mask);
+    saved_mask_.assign(bytes, bytes + sizeof(old_mask));
+  }
+#else
+  (void)part;
+  (void)parts;
+#endif
+}
+
+S21ThreadPin::~S21ThreadPin() {
+#ifdef __linux__
+  if (pinned_) {
+    cpu_set_t mask;
+    std::memcpy(&mask, saved_mask_.data(), sizeof(mask));
+    sched_setaffinity(0, sizeof(mask), &mask);
+  }
+#endif
+}
@@ -0,0 +1,61 @@
+#ifndef SRC_S21_NUMA_H_
+#define SRC_S21_NUMA_H_
+
+#include <cstddef>
+#include <vector>
+
+/// @brief Размещение больших матриц по узлам NUMA. Действует на буферы от
+/// kNumaMinBytes, меньшие выделяются обычным new
+enum class S21NumaPolicy {
+  kDefault,     // страницы попадают на узел потока, который первым их запишет
+  kFirstTouch,  // строки делятся на блоки по числу узлов, как в
+                // kBindBlocks; блок k обнуляет поток, привязанный к узлу
+                // k, и его страницы размещаются на этом узле
+  kInterleave,  // страницы чередуются по всем узлам
+  kBindBlocks   // строки делятся на блоки по числу узлов, блок k
+                // предпочтительно размещается на узле k
+};
+
+/// @brief С какого размера буфера (в байтах) применяется политика
+constexpr size_t kNumaMinBytes = size_t{1} << 21;
+
+/// @brief Кол-во узлов NUMA, на которых есть доступные процессу ядра. На
+/// одноузловых машинах и вне Linux - 1
+int S21NumaNodeCount();
+
+/// @brief Политика размещения новых матриц
+void S21SetNumaPolicy(S21NumaPolicy policy);
+S21NumaPolicy S21GetNumaPolicy();
+
+/// @brief Включает привязку потоков S21ParallelFor к ядрам: часть p из n
+/// выполняется на ядре узла p * узлы / n. Части идут подряд по строкам,
+/// поэтому при любом grain часть работает на узле своих строк при
+/// kFirstTouch и kBindBlocks (с точностью до строк на границе блоков)
+void S21SetThreadPinning(bool enable);
+bool S21GetThreadPinning();
+
+/// @brief Выделяет обнуленный буфер rows * cols по текущей политике.
+/// Ошибки системных вызовов размещения не считаются ошибками: память просто
+/// остается там, куда ее поместило ядро
+/// @return буфер, освобождать через S21NumaFree с тем же размером
+double *S21NumaAllocate(int rows, int cols);
+
+/// @brief Освобождает буфер S21NumaAllocate
+void S21NumaFree(double *data, int rows, int cols);
+
+/// @brief На время жизни объекта привязывает текущий поток к ядру для части
+/// part из parts, если привязка включена; деструктор возвращает прежнюю маску
+class S21ThreadPin {
+ public:
+  S21ThreadPin(int part, int parts);
+  ~S21ThreadPin();
+
+  S21ThreadPin(const S21ThreadPin &other) = delete;
+  S21ThreadPin &operator=(const S21ThreadPin &other) = delete;
+
+ private:
+  bool pinned_;
+  std::vector<unsigned char> saved_mask_;
+};
+
+#endif  // SRC_S21_NUMA_H_
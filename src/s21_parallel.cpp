@@ -0,0 +1,67 @@
+#include "s21_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "s21_numa.h"
+
+namespace {
+
+std::atomic<int> thread_count{0};
+
+}  // namespace
+
+int S21GetThreadCount() {
+  int threads = thread_count.load();
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  return std::max(1, threads);
+}
+
+void S21SetThreadCount(int threads) { thread_count.store(std::max(0, threads)); }
+
+int S21ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int, int)> &body) {
+  int length = end - begin;
+  if (length <= 0) {
+    return 0;
+  }
+  grain = std::max(1, grain);
+  int parts = std::min(S21GetThreadCount(), length / grain);
+  if (parts <= 1) {
+    body(0, begin, end);
+    return 1;
+  }
+  // Первая часть выполняется в вызывающем потоке
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(parts);
+  auto run = [&](int part) {
+    S21ThreadPin pin(part, parts);
+    int part_begin = begin + static_cast<int>(
+                                 static_cast<long long>(length) * part / parts);
+    int part_end = begin + static_cast<int>(static_cast<long long>(length) *
+                                            (part + 1) / parts);
+    try {
+      body(part, part_begin, part_end);
+    } catch (...) {
+      errors[part] = std::current_exception();
+    }
+  };
+  for (int part = 1; part < parts; part++) {
+    workers.emplace_back(run, part);
+  }
+  run(0);
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  for (const std::exception_ptr &error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return parts;
+}
@@ -0,0 +1,26 @@
+#ifndef SRC_S21_PARALLEL_H_
+#define SRC_S21_PARALLEL_H_
+
+#include <functional>
+
+/// @brief Кол-во потоков, которое используют параллельные операции
+/// библиотеки
+int S21GetThreadCount();
+
+/// @brief Задает кол-во потоков для параллельных операций
+/// @param threads кол-во потоков (0 - по числу ядер)
+void S21SetThreadCount(int threads);
+
+/// @brief Делит диапазон [begin, end) на непрерывные части и выполняет их
+/// параллельно. Части нумеруются по порядку, поэтому частичные результаты
+/// можно объединять детерминированно. Если диапазон меньше двух grain, все
+/// выполняется в вызывающем потоке
+/// @param begin начало диапазона
+/// @param end конец диапазона
+/// @param grain минимальный размер части
+/// @param body функция (номер части, начало, конец)
+/// @return кол-во частей, на которые был разбит диапазон
+int S21ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int, int)> &body);
+
+#endif  // SRC_S21_PARALLEL_H_
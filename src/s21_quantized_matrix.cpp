@@ -0,0 +1,295 @@
+#include "s21_quantized_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "s21_parallel.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define S21_X86_KERNELS
+#endif
+
+namespace {
+
+// Строки дополняются до кратной длины: один регистр AVX2 - 32 байта
+constexpr int kRowAlign = 32;
+// Сколько строк b проходит по всем строкам части a, пока они в кэше
+constexpr int kRowBlock = 64;
+// Минимум строк a на поток
+constexpr int kParallelRows = 16;
+// Наибольшая глубина, при которой сумма произведений (qa - za)(qb - zb),
+// каждое до 255 * 255 по модулю, точно помещается в int32
+constexpr int kMaxDepth = std::numeric_limits<int32_t>::max() / (255 * 255);
+
+std::atomic<int> requested_kernel{static_cast<int>(S21Int8Kernel::kAuto)};
+
+// Скалярное произведение двух строк длины n (n кратно kRowAlign). b_sum -
+// сумма строки b, она нужна ядру, которое работает со смещенной a
+using DotKernel = int32_t (*)(const int8_t *a, const int8_t *b, int n,
+                              int32_t b_sum);
+
+int32_t DotPortable(const int8_t *a, const int8_t *b, int n, int32_t) {
+  int32_t sum = 0;
+  for (int k = 0; k < n; k++) {
+    sum += static_cast<int32_t>(a[k]) * b[k];
+  }
+  return sum;
+}
+
+#ifdef S21_X86_KERNELS
+__attribute__((target("avx2"))) inline int32_t HorizontalSum(__m256i v) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// int8 расширяются до int16, madd складывает пары произведений в int32 без
+// насыщения
+__attribute__((target("avx2"))) int32_t DotAvx2(const int8_t *a,
+                                                const int8_t *b, int n,
+                                                int32_t) {
+  __m256i acc = _mm256_setzero_si256();
+  for (int k = 0; k < n; k += kRowAlign) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + k));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + k));
+    __m256i a_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(va));
+    __m256i a_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(va, 1));
+    __m256i b_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vb));
+    __m256i b_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vb, 1));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a_lo, b_lo));
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a_hi, b_hi));
+  }
+  return HorizontalSum(acc);
+}
+
+// dpbusd умножает беззнаковые байты на знаковые: a сдвигается на 128
+// (xor 0x80), лишнее 128 * sum(b) вычитается в конце
+__attribute__((target("avx512vnni,avx512vl,avx2"))) int32_t DotVnni(
+    const int8_t *a, const int8_t *b, int n, int32_t b_sum) {
+  const __m256i flip = _mm256_set1_epi8(static_cast<char>(0x80));
+  __m256i acc = _mm256_setzero_si256();
+  for (int k = 0; k < n; k += kRowAlign) {
+    __m256i va = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + k)), flip);
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + k));
+    acc = _mm256_dpbusd_epi32(acc, va, vb);
+  }
+  return HorizontalSum(acc) - 128 * b_sum;
+}
+#endif
+
+bool Supported(S21Int8Kernel kernel) {
+#ifdef S21_X86_KERNELS
+  if (kernel == S21Int8Kernel::kAvx2) {
+    return __builtin_cpu_supports("avx2");
+  }
+  if (kernel == S21Int8Kernel::kVnni) {
+    return __builtin_cpu_supports("avx2") &&
+           __builtin_cpu_supports("avx512vnni") &&
+           __builtin_cpu_supports("avx512vl");
+  }
+#endif
+  return kernel == S21Int8Kernel::kPortable;
+}
+
+DotKernel KernelFunction(S21Int8Kernel kernel) {
+#ifdef S21_X86_KERNELS
+  if (kernel == S21Int8Kernel::kVnni) {
+    return DotVnni;
+  }
+  if (kernel == S21Int8Kernel::kAvx2) {
+    return DotAvx2;
+  }
+#else
+  (void)kernel;
+#endif
+  return DotPortable;
+}
+
+// Масштаб и нулевая точка для диапазона [lo, hi], расширенного до нуля
+void ChooseParameters(double lo, double hi, double *scale, int32_t *zero) {
+  if (!std::isfinite(lo) || !std::isfinite(hi)) {
+    throw std::invalid_argument("Matrix contains non-finite values.");
+  }
+  lo = std::min(lo, 0.0);
+  hi = std::max(hi, 0.0);
+  if (hi == lo) {
+    *scale = 1.0;
+    *zero = 0;
+    return;
+  }
+  *scale = (hi - lo) / 255.0;
+  double point = std::round(-128.0 - lo / *scale);
+  *zero = static_cast<int32_t>(std::clamp(point, -128.0, 127.0));
+}
+
+int8_t QuantizeValue(double x, double scale, int32_t zero) {
+  double q = std::round(x / scale) + zero;
+  return static_cast<int8_t>(std::clamp(q, -128.0, 127.0));
+}
+
+}  // namespace
+
+S21QuantizedMatrix::S21QuantizedMatrix(const S21Matrix &matrix,
+                                       S21Quantization mode)
+    : rows_(matrix.GetRows()),
+      cols_(matrix.GetCols()),
+      stride_((matrix.GetCols() + kRowAlign - 1) / kRowAlign * kRowAlign),
+      mode_(mode),
+      values_(static_cast<size_t>(rows_) * stride_, 0),
+      scales_(rows_),
+      zero_points_(rows_),
+      row_sums_(rows_, 0) {
+  double tensor_scale = 1.0;
+  int32_t tensor_zero = 0;
+  if (mode == S21Quantization::kPerTensor) {
+    ChooseParameters(matrix.Min(), matrix.Max(), &tensor_scale, &tensor_zero);
+  }
+  for (int i = 0; i < rows_; i++) {
+    const double *row = &matrix(i, 0);
+    if (mode == S21Quantization::kPerRow) {
+      auto range = std::minmax_element(row, row + cols_);
+      ChooseParameters(*range.first, *range.second, &scales_[i],
+                       &zero_points_[i]);
+    } else {
+      scales_[i] = tensor_scale;
+      zero_points_[i] = tensor_zero;
+    }
+    int8_t *out = values_.data() + static_cast<size_t>(i) * stride_;
+    int32_t sum = 0;
+    for (int j = 0; j < cols_; j++) {
+      out[j] = QuantizeValue(row[j], scales_[i], zero_points_[i]);
+      sum += out[j];
+    }
+    row_sums_[i] = sum;
+  }
+}
+
+int S21QuantizedMatrix::GetRows() const { return rows_; }
+
+int S21QuantizedMatrix::GetCols() const { return cols_; }
+
+S21Quantization S21QuantizedMatrix::GetMode() const { return mode_; }
+
+int8_t S21QuantizedMatrix::GetValue(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  return values_[static_cast<size_t>(i) * stride_ + j];
+}
+
+double S21QuantizedMatrix::GetScale(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  return scales_[row];
+}
+
+int S21QuantizedMatrix::GetZeroPoint(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  return zero_points_[row];
+}
+
+S21Matrix S21QuantizedMatrix::Dequantize() const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const int8_t *in = values_.data() + static_cast<size_t>(i) * stride_;
+    double *out = &result(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      out[j] = (in[j] - zero_points_[i]) * scales_[i];
+    }
+  }
+  return result;
+}
+
+S21QuantizedProduct S21QuantizedMatrix::MulTransposed(
+    const S21QuantizedMatrix &a, const S21QuantizedMatrix &b) {
+  if (a.cols_ != b.cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  if (a.cols_ > kMaxDepth) {
+    throw std::invalid_argument("Matrix is too wide for int32 accumulation.");
+  }
+  S21QuantizedProduct product;
+  product.rows_ = a.rows_;
+  product.cols_ = b.rows_;
+  product.values_.resize(static_cast<size_t>(a.rows_) * b.rows_);
+  product.row_scales_ = a.scales_;
+  product.col_scales_ = b.scales_;
+
+  DotKernel dot = KernelFunction(GetKernel());
+  long long depth = a.cols_;
+  S21ParallelFor(0, a.rows_, kParallelRows, [&](int, int begin, int end) {
+    for (int j0 = 0; j0 < b.rows_; j0 += kRowBlock) {
+      int j1 = std::min(b.rows_, j0 + kRowBlock);
+      for (int i = begin; i < end; i++) {
+        const int8_t *a_row =
+            a.values_.data() + static_cast<size_t>(i) * a.stride_;
+        long long za = a.zero_points_[i];
+        int32_t *out =
+            product.values_.data() + static_cast<size_t>(i) * b.rows_;
+        for (int j = j0; j < j1; j++) {
+          const int8_t *b_row =
+              b.values_.data() + static_cast<size_t>(j) * b.stride_;
+          long long zb = b.zero_points_[j];
+          // sum (qa - za)(qb - zb) = sum qa*qb - zb*sum qa - za*sum qb +
+          // k*za*zb
+          long long sum = dot(a_row, b_row, a.stride_, b.row_sums_[j]);
+          sum += -zb * a.row_sums_[i] - za * b.row_sums_[j] + depth * za * zb;
+          out[j] = static_cast<int32_t>(sum);
+        }
+      }
+    }
+  });
+  return product;
+}
+
+void S21QuantizedMatrix::SetKernel(S21Int8Kernel kernel) {
+  requested_kernel.store(static_cast<int>(kernel));
+}
+
+S21Int8Kernel S21QuantizedMatrix::GetKernel() {
+  S21Int8Kernel kernel = static_cast<S21Int8Kernel>(requested_kernel.load());
+  if (kernel != S21Int8Kernel::kAuto && Supported(kernel)) {
+    return kernel;
+  }
+  if (Supported(S21Int8Kernel::kVnni)) {
+    return S21Int8Kernel::kVnni;
+  }
+  if (Supported(S21Int8Kernel::kAvx2)) {
+    return S21Int8Kernel::kAvx2;
+  }
+  return S21Int8Kernel::kPortable;
+}
+
+int S21QuantizedProduct::GetRows() const { return rows_; }
+
+int S21QuantizedProduct::GetCols() const { return cols_; }
+
+int32_t S21QuantizedProduct::GetElement(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  return values_[static_cast<size_t>(i) * cols_ + j];
+}
+
+S21Matrix S21QuantizedProduct::Dequantize() const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const int32_t *in = values_.data() + static_cast<size_t>(i) * cols_;
+    double *out = &result(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      out[j] = in[j] * row_scales_[i] * col_scales_[j];
+    }
+  }
+  return result;
+}
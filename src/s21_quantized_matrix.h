@@ -0,0 +1,102 @@
+#ifndef SRC_S21_QUANTIZED_MATRIX_H_
+#define SRC_S21_QUANTIZED_MATRIX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Для каких элементов общие масштаб и нулевая точка
+enum class S21Quantization {
+  kPerTensor,  // одни на всю матрицу
+  kPerRow      // свои для каждой строки
+};
+
+/// @brief Реализация произведения int8 x int8 -> int32
+enum class S21Int8Kernel {
+  kAuto,      // лучшая из поддерживаемых процессором
+  kPortable,  // переносимый код без SIMD
+  kAvx2,      // AVX2: расширение до int16 и _mm256_madd_epi16
+  kVnni       // AVX-512 VNNI: _mm256_dpbusd_epi32, 32 произведения за такт
+};
+
+class S21QuantizedProduct;
+
+/// @brief Матрица int8 с масштабом и нулевой точкой: x = (q - zero) * scale.
+/// Диапазон всегда включает 0, поэтому ноль представляется точно. Строки
+/// дополняются нулями до кратной 32 длины, чтобы SIMD-ядра читали их
+/// целиком
+class S21QuantizedMatrix {
+ public:
+  /// @brief Квантование матрицы
+  /// @param matrix исходная матрица
+  /// @param mode общие параметры на всю матрицу или на каждую строку
+  S21QuantizedMatrix(const S21Matrix &matrix, S21Quantization mode);
+
+  int GetRows() const;
+  int GetCols() const;
+  S21Quantization GetMode() const;
+
+  /// @brief Квантованное значение элемента
+  int8_t GetValue(int i, int j) const;
+
+  /// @brief Масштаб и нулевая точка строки
+  double GetScale(int row) const;
+  int GetZeroPoint(int row) const;
+
+  /// @brief Обратное преобразование в S21Matrix
+  S21Matrix Dequantize() const;
+
+  /// @brief Целочисленное произведение a * b^T: строки b - это столбцы
+  /// правого множителя, как веса линейного слоя (out x in). Для обычного
+  /// a * w квантуйте w.Transpose(), тогда kPerRow дает масштаб на каждый
+  /// столбец результата. Нулевые точки учитываются через суммы строк, так
+  /// что ядро умножает только сами int8. Накопление в int32 точное, поэтому
+  /// k не больше 33025: при большей глубине сумма может не поместиться
+  /// @throw std::invalid_argument размеры не согласованы или k > 33025
+  /// @param a левый множитель (m x k)
+  /// @param b правый множитель в транспонированном виде (n x k)
+  /// @return произведение (m x n) в int32 с масштабами для Dequantize
+  static S21QuantizedProduct MulTransposed(const S21QuantizedMatrix &a,
+                                           const S21QuantizedMatrix &b);
+
+  /// @brief Выбор ядра умножения. Если процессор не поддерживает
+  /// запрошенное, используется лучшее доступное
+  static void SetKernel(S21Int8Kernel kernel);
+
+  /// @brief Ядро, которое будет использовано на самом деле
+  static S21Int8Kernel GetKernel();
+
+ private:
+  int rows_;
+  int cols_;
+  int stride_;  // длина строки в values_ с дополнением
+  S21Quantization mode_;
+  std::vector<int8_t> values_;
+  std::vector<double> scales_;
+  std::vector<int32_t> zero_points_;
+  std::vector<int32_t> row_sums_;  // суммы q по строкам
+};
+
+/// @brief Произведение квантованных матриц: точные суммы
+/// (qa - za) * (qb - zb) в int32 и масштабы строк и столбцов
+class S21QuantizedProduct {
+ public:
+  int GetRows() const;
+  int GetCols() const;
+  int32_t GetElement(int i, int j) const;
+
+  /// @brief Значение произведения: element * scale_row * scale_col
+  S21Matrix Dequantize() const;
+
+ private:
+  friend class S21QuantizedMatrix;
+
+  int rows_ = 0;
+  int cols_ = 0;
+  std::vector<int32_t> values_;
+  std::vector<double> row_scales_;
+  std::vector<double> col_scales_;
+};
+
+#endif  // SRC_S21_QUANTIZED_MATRIX_H_
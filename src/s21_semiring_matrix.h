@@ -0,0 +1,378 @@
+#ifndef SRC_S21_SEMIRING_MATRIX_H_
+#define SRC_S21_SEMIRING_MATRIX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_parallel.h"
+
+// Полукольцо задает тип значений Value, нейтральные Zero (для сложения,
+// поглощает при умножении) и One, операции Add и Mul, а также FromDouble и
+// ToDouble для обмена с S21Matrix. kIdempotent - выполняется ли Add(a, a) =
+// a; от этого зависит, доступно ли Closure
+
+/// @brief Тропическое (min, +): кратчайшие пути, +inf - нет ребра
+struct S21MinPlus {
+  using Value = double;
+  static constexpr bool kIdempotent = true;
+  Value Zero() const { return std::numeric_limits<double>::infinity(); }
+  Value One() const { return 0.0; }
+  Value Add(Value a, Value b) const { return std::min(a, b); }
+  Value Mul(Value a, Value b) const { return a + b; }
+  Value FromDouble(double x) const { return x; }
+  double ToDouble(Value x) const { return x; }
+};
+
+/// @brief Тропическое (max, +): самые длинные пути в ациклических графах,
+/// -inf - нет ребра
+struct S21MaxPlus {
+  using Value = double;
+  static constexpr bool kIdempotent = true;
+  Value Zero() const { return -std::numeric_limits<double>::infinity(); }
+  Value One() const { return 0.0; }
+  Value Add(Value a, Value b) const { return std::max(a, b); }
+  Value Mul(Value a, Value b) const { return a + b; }
+  Value FromDouble(double x) const { return x; }
+  double ToDouble(Value x) const { return x; }
+};
+
+/// @brief Булево (or, and): достижимость. Ненулевой double - это 1
+struct S21Boolean {
+  using Value = uint8_t;
+  static constexpr bool kIdempotent = true;
+  Value Zero() const { return 0; }
+  Value One() const { return 1; }
+  Value Add(Value a, Value b) const { return a | b; }
+  Value Mul(Value a, Value b) const { return a & b; }
+  Value FromDouble(double x) const { return x != 0.0; }
+  double ToDouble(Value x) const { return x; }
+};
+
+/// @brief Вычеты по модулю p < 2^64: произведение считается в 128 битах
+class S21ModP {
+ public:
+  using Value = uint64_t;
+  static constexpr bool kIdempotent = false;
+
+  /// @throw std::invalid_argument модуль меньше 2
+  explicit S21ModP(uint64_t modulus = 1000000007) : modulus_(modulus) {
+    if (modulus < 2) {
+      throw std::invalid_argument("Modulus must be at least 2.");
+    }
+  }
+
+  uint64_t GetModulus() const { return modulus_; }
+  Value Zero() const { return 0; }
+  Value One() const { return 1; }
+  Value Add(Value a, Value b) const {
+    // a + b может переполнить 64 бита, если p > 2^63
+    Value sum = a + b;
+    return sum < a || sum >= modulus_ ? sum - modulus_ : sum;
+  }
+  Value Mul(Value a, Value b) const {
+    return static_cast<Value>(static_cast<unsigned __int128>(a) * b %
+                              modulus_);
+  }
+  /// @brief Целая часть x по модулю p, отрицательные приводятся в [0, p).
+  /// Приведение точное при любом p: double(p) при p >= 2^53 округлен, поэтому
+  /// |x| раскладывается на целую мантиссу и степень двойки
+  /// @throw std::invalid_argument x - бесконечность или NaN
+  Value FromDouble(double x) const {
+    if (!std::isfinite(x)) {
+      throw std::invalid_argument("Residue of a non-finite value.");
+    }
+    int exponent = 0;
+    double fraction = std::frexp(std::trunc(std::abs(x)), &exponent);
+    // |x| = mantissa * 2^shift, мантисса - целое меньше 2^53
+    int shift = std::max(0, exponent - std::numeric_limits<double>::digits);
+    Value mantissa = static_cast<Value>(std::ldexp(fraction, exponent - shift));
+    Value value = Mul(mantissa % modulus_, PowerOfTwo(shift));
+    return x < 0 && value != 0 ? modulus_ - value : value;
+  }
+  double ToDouble(Value x) const { return static_cast<double>(x); }
+
+ private:
+  // 2^shift по модулю p
+  Value PowerOfTwo(int shift) const {
+    Value result = 1;
+    Value base = 2 % modulus_;
+    for (; shift > 0; shift >>= 1) {
+      if (shift & 1) {
+        result = Mul(result, base);
+      }
+      base = Mul(base, base);
+    }
+    return result;
+  }
+
+  uint64_t modulus_;
+};
+
+/// @brief Матрица над полукольцом. Умножение - тот же блочный алгоритм,
+/// что у S21Matrix, но с операциями полукольца; блоки строк результата
+/// обрабатываются параллельно
+template <typename Semiring>
+class S21SemiringMatrix {
+ public:
+  using Value = typename Semiring::Value;
+
+  /// @brief Матрица из нулей полукольца (для графа - без ребер)
+  /// @throw std::invalid_argument rows или cols <= 0
+  S21SemiringMatrix(int rows, int cols, const Semiring &semiring = Semiring());
+
+  /// @brief Поэлементное преобразование S21Matrix через FromDouble
+  explicit S21SemiringMatrix(const S21Matrix &matrix,
+                             const Semiring &semiring = Semiring());
+
+  /// @brief Единица полукольца на диагонали, ноль вне ее
+  static S21SemiringMatrix Identity(int size,
+                                    const Semiring &semiring = Semiring());
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  const Semiring &GetSemiring() const { return semiring_; }
+
+  /// @throw std::out_of_range индекс вне матрицы
+  Value &operator()(int i, int j);
+  const Value &operator()(int i, int j) const;
+
+  /// @brief Поэлементное Add
+  S21SemiringMatrix operator+(const S21SemiringMatrix &other) const;
+
+  /// @brief c(i, j) = Add по k от Mul(a(i, k), b(k, j))
+  S21SemiringMatrix operator*(const S21SemiringMatrix &other) const;
+
+  /// @brief Степень бинарным возведением, степень 0 - Identity. Для
+  /// (min, +) k-я степень - кратчайшие пути не более чем из k ребер
+  /// @throw std::logic_error матрица не квадратная
+  /// @throw std::invalid_argument отрицательная степень
+  S21SemiringMatrix Power(long long k) const;
+
+  /// @brief Замыкание I + A + A^2 + ...: возводит I + A в квадрат, пока
+  /// матрица меняется (не более log2(n) раз). (I + A)^(2^s) равно сумме
+  /// степеней только при идемпотентном сложении, поэтому для других
+  /// полуколец (S21ModP) метод не компилируется. Для (min, +) без
+  /// отрицательных циклов - кратчайшие пути между всеми парами, для
+  /// булева - рефлексивно-транзитивное замыкание
+  /// @throw std::logic_error матрица не квадратная
+  S21SemiringMatrix Closure() const;
+
+  /// @brief Поэлементное преобразование в S21Matrix через ToDouble
+  S21Matrix ToMatrix() const;
+
+  bool operator==(const S21SemiringMatrix &other) const {
+    return rows_ == other.rows_ && cols_ == other.cols_ &&
+           values_ == other.values_;
+  }
+
+ private:
+  // Размер блока, как у умножения S21Matrix
+  static constexpr int kBlock = 64;
+
+  static void MulInto(const S21SemiringMatrix &a, const S21SemiringMatrix &b,
+                      S21SemiringMatrix &dst);
+  void CheckSquare() const;
+
+  int rows_;
+  int cols_;
+  Semiring semiring_;
+  std::vector<Value> values_;
+};
+
+// Шаблонные методы: операции полукольца встраиваются во внутренний цикл,
+// который компилятор может векторизовать
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring>::S21SemiringMatrix(int rows, int cols,
+                                               const Semiring &semiring)
+    : rows_(rows), cols_(cols), semiring_(semiring) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+  values_.assign(static_cast<size_t>(rows) * cols, semiring_.Zero());
+}
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring>::S21SemiringMatrix(const S21Matrix &matrix,
+                                               const Semiring &semiring)
+    : S21SemiringMatrix(matrix.GetRows(), matrix.GetCols(), semiring) {
+  for (int i = 0; i < rows_; i++) {
+    const double *row = &matrix(i, 0);
+    Value *out = values_.data() + static_cast<size_t>(i) * cols_;
+    for (int j = 0; j < cols_; j++) {
+      out[j] = semiring_.FromDouble(row[j]);
+    }
+  }
+}
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring> S21SemiringMatrix<Semiring>::Identity(
+    int size, const Semiring &semiring) {
+  S21SemiringMatrix result(size, size, semiring);
+  for (int i = 0; i < size; i++) {
+    result.values_[static_cast<size_t>(i) * size + i] = semiring.One();
+  }
+  return result;
+}
+
+template <typename Semiring>
+typename Semiring::Value &S21SemiringMatrix<Semiring>::operator()(int i,
+                                                                  int j) {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix index is out of range.");
+  }
+  return values_[static_cast<size_t>(i) * cols_ + j];
+}
+
+template <typename Semiring>
+const typename Semiring::Value &S21SemiringMatrix<Semiring>::operator()(
+    int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Matrix index is out of range.");
+  }
+  return values_[static_cast<size_t>(i) * cols_ + j];
+}
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring> S21SemiringMatrix<Semiring>::operator+(
+    const S21SemiringMatrix &other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+  S21SemiringMatrix result(rows_, cols_, semiring_);
+  for (size_t k = 0; k < values_.size(); k++) {
+    result.values_[k] = semiring_.Add(values_[k], other.values_[k]);
+  }
+  return result;
+}
+
+template <typename Semiring>
+void S21SemiringMatrix<Semiring>::MulInto(const S21SemiringMatrix &a,
+                                          const S21SemiringMatrix &b,
+                                          S21SemiringMatrix &dst) {
+  const Semiring &semiring = a.semiring_;
+  const Value zero = semiring.Zero();
+  std::fill(dst.values_.begin(), dst.values_.end(), zero);
+  int n = b.cols_;
+  int blocks = (a.rows_ + kBlock - 1) / kBlock;
+  S21ParallelFor(0, blocks, 1, [&](int, int block_begin, int block_end) {
+    for (int i0 = block_begin * kBlock;
+         i0 < std::min(block_end * kBlock, a.rows_); i0 += kBlock) {
+      int i1 = std::min(i0 + kBlock, a.rows_);
+      for (int k0 = 0; k0 < a.cols_; k0 += kBlock) {
+        int k1 = std::min(k0 + kBlock, a.cols_);
+        for (int j0 = 0; j0 < n; j0 += kBlock) {
+          int j1 = std::min(j0 + kBlock, n);
+          for (int i = i0; i < i1; i++) {
+            Value *out = dst.values_.data() + static_cast<size_t>(i) * n;
+            const Value *a_row =
+                a.values_.data() + static_cast<size_t>(i) * a.cols_;
+            for (int k = k0; k < k1; k++) {
+              Value aik = a_row[k];
+              // Ноль поглощает: для разреженных графов это большая часть
+              // работы
+              if (aik == zero) {
+                continue;
+              }
+              const Value *row = b.values_.data() + static_cast<size_t>(k) * n;
+              for (int j = j0; j < j1; j++) {
+                out[j] = semiring.Add(out[j], semiring.Mul(aik, row[j]));
+              }
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring> S21SemiringMatrix<Semiring>::operator*(
+    const S21SemiringMatrix &other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  S21SemiringMatrix result(rows_, other.cols_, semiring_);
+  MulInto(*this, other, result);
+  return result;
+}
+
+template <typename Semiring>
+void S21SemiringMatrix<Semiring>::CheckSquare() const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+}
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring> S21SemiringMatrix<Semiring>::Power(
+    long long k) const {
+  CheckSquare();
+  if (k < 0) {
+    throw std::invalid_argument("Negative power of a semiring matrix.");
+  }
+  // Бинарное возведение с обменом буферов, как в S21Matrix::Power
+  S21SemiringMatrix result = Identity(rows_, semiring_);
+  S21SemiringMatrix base(*this);
+  S21SemiringMatrix scratch(rows_, cols_, semiring_);
+  bool result_set = false;
+  while (k > 0) {
+    if (k & 1) {
+      if (result_set) {
+        MulInto(result, base, scratch);
+        std::swap(result.values_, scratch.values_);
+      } else {
+        result.values_ = base.values_;
+        result_set = true;
+      }
+    }
+    k >>= 1;
+    if (k > 0) {
+      MulInto(base, base, scratch);
+      std::swap(base.values_, scratch.values_);
+    }
+  }
+  return result;
+}
+
+template <typename Semiring>
+S21SemiringMatrix<Semiring> S21SemiringMatrix<Semiring>::Closure() const {
+  static_assert(Semiring::kIdempotent,
+                "Closure requires an idempotent semiring addition.");
+  CheckSquare();
+  S21SemiringMatrix result = Identity(rows_, semiring_) + *this;
+  S21SemiringMatrix scratch(rows_, cols_, semiring_);
+  // (I + A)^(2^s) покрывает пути до 2^s ребер; после n - 1 ребер и при
+  // неподвижной точке новых путей нет
+  for (long long covered = 1; covered < rows_ - 1; covered *= 2) {
+    MulInto(result, result, scratch);
+    if (scratch.values_ == result.values_) {
+      break;
+    }
+    std::swap(result.values_, scratch.values_);
+  }
+  return result;
+}
+
+template <typename Semiring>
+S21Matrix S21SemiringMatrix<Semiring>::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const Value *in = values_.data() + static_cast<size_t>(i) * cols_;
+    double *out = &result(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      out[j] = semiring_.ToDouble(in[j]);
+    }
+  }
+  return result;
+}
+
+#endif  // SRC_S21_SEMIRING_MATRIX_H_
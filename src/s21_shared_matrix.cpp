@@ -0,0 +1,293 @@
+#include "s21_shared_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define S21_POSIX_SHM
+#endif
+
+struct S21SharedMatrix::Header {
+  uint64_t magic;
+  uint32_t format;  // версия разметки сегмента
+  int32_t rows;
+  int32_t cols;
+  uint32_t data_offset;
+  std::atomic<uint32_t> ready;
+  std::atomic<uint64_t> version;
+};
+
+namespace {
+
+constexpr uint64_t kMagic = 0x5852544D31325300;  // "\0S21MTRX"
+constexpr uint32_t kFormat = 1;
+// Данные начинаются с границы строки кэша
+constexpr size_t kDataOffset = 64;
+// Период опроса при ожидании сегмента
+constexpr auto kPollInterval = std::chrono::milliseconds(1);
+
+std::string SegmentName(const std::string &name) {
+  return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+std::string SystemError(const std::string &what, const std::string &name) {
+  return what + " " + name + ": " + std::strerror(errno);
+}
+
+}  // namespace
+
+S21SharedMatrix::S21SharedMatrix(const std::string &name, void *memory,
+                                 size_t size, bool writable)
+    : name_(name),
+      memory_(memory),
+      size_(size),
+      header_(static_cast<Header *>(memory)),
+      data_(reinterpret_cast<double *>(static_cast<char *>(memory) +
+                                       kDataOffset)),
+      writable_(writable) {}
+
+S21SharedMatrix::S21SharedMatrix(S21SharedMatrix &&other) noexcept
+    : name_(std::move(other.name_)),
+      memory_(other.memory_),
+      size_(other.size_),
+      header_(other.header_),
+      data_(other.data_),
+      writable_(other.writable_) {
+  other.memory_ = nullptr;
+  other.header_ = nullptr;
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+S21SharedMatrix &S21SharedMatrix::operator=(S21SharedMatrix &&other) noexcept {
+  if (this != &other) {
+    Release();
+    name_ = std::move(other.name_);
+    std::swap(memory_, other.memory_);
+    std::swap(size_, other.size_);
+    std::swap(header_, other.header_);
+    std::swap(data_, other.data_);
+    writable_ = other.writable_;
+  }
+  return *this;
+}
+
+S21SharedMatrix::~S21SharedMatrix() { Release(); }
+
+void S21SharedMatrix::Release() {
+#ifdef S21_POSIX_SHM
+  if (memory_) {
+    munmap(memory_, size_);
+  }
+#endif
+  memory_ = nullptr;
+  header_ = nullptr;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+S21SharedMatrix S21SharedMatrix::Create(const std::string &name, int rows,
+                                        int cols) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+  static_assert(sizeof(Header) <= kDataOffset, "Header must fit before data");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "Atomics in shared memory must be lock-free");
+  std::string path = SegmentName(name);
+#ifdef S21_POSIX_SHM
+  size_t size = kDataOffset + static_cast<size_t>(rows) * cols * sizeof(double);
+  int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    throw std::runtime_error(SystemError("Cannot create shared matrix", path));
+  }
+  // ftruncate заполняет сегмент нулями, поэтому флаг готовности снят сразу
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    std::string error = SystemError("Cannot resize shared matrix", path);
+    close(fd);
+    shm_unlink(path.c_str());
+    throw std::runtime_error(error);
+  }
+  void *memory =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    std::string error = SystemError("Cannot map shared matrix", path);
+    shm_unlink(path.c_str());
+    throw std::runtime_error(error);
+  }
+  Header *header = new (memory) Header;
+  header->magic = kMagic;
+  header->format = kFormat;
+  header->rows = rows;
+  header->cols = cols;
+  header->data_offset = kDataOffset;
+  header->ready.store(0, std::memory_order_relaxed);
+  header->version.store(0, std::memory_order_relaxed);
+  return S21SharedMatrix(path, memory, size, true);
+#else
+  throw std::runtime_error("Shared memory is not supported: " + path);
+#endif
+}
+
+S21SharedMatrix S21SharedMatrix::Publish(const std::string &name,
+                                         const S21Matrix &matrix) {
+  S21SharedMatrix shared = Create(name, matrix.GetRows(), matrix.GetCols());
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    std::copy(&matrix(i, 0), &matrix(i, 0) + matrix.GetCols(),
+              shared.data_ + static_cast<size_t>(i) * matrix.GetCols());
+  }
+  shared.MarkReady();
+  return shared;
+}
+
+S21SharedMatrix S21SharedMatrix::Attach(const std::string &name,
+                                        int timeout_ms) {
+  std::string path = SegmentName(name);
+#ifdef S21_POSIX_SHM
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(std::max(0, timeout_ms));
+  while (true) {
+    int fd = shm_open(path.c_str(), O_RDONLY, 0);
+    if (fd < 0 && errno != ENOENT) {
+      throw std::runtime_error(
+          SystemError("Cannot open shared matrix", path));
+    }
+    if (fd >= 0) {
+      struct stat info;
+      size_t size = 0;
+      if (fstat(fd, &info) == 0) {
+        size = static_cast<size_t>(info.st_size);
+      }
+      void *memory = MAP_FAILED;
+      if (size >= kDataOffset) {
+        memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      }
+      close(fd);
+      if (memory != MAP_FAILED) {
+        const Header *header = static_cast<const Header *>(memory);
+        if (header->ready.load(std::memory_order_acquire)) {
+          // Заголовок проверяется только у готового сегмента: до этого
+          // создатель мог его еще не записать
+          size_t needed = kDataOffset + static_cast<size_t>(header->rows) *
+                                            header->cols * sizeof(double);
+          if (header->magic != kMagic || header->format != kFormat ||
+              header->data_offset != kDataOffset || header->rows <= 0 ||
+              header->cols <= 0 || size < needed) {
+            munmap(memory, size);
+            throw std::runtime_error("Segment " + path +
+                                     " is not a shared matrix.");
+          }
+          return S21SharedMatrix(path, memory, size, false);
+        }
+        munmap(memory, size);
+      }
+    }
+    if (std::chrono::steady_clock::now() >= deadline) {
+      throw std::runtime_error("Shared matrix " + path + " is not ready.");
+    }
+    std::this_thread::sleep_for(kPollInterval);
+  }
+#else
+  (void)timeout_ms;
+  throw std::runtime_error("Shared memory is not supported: " + path);
+#endif
+}
+
+void S21SharedMatrix::Unlink(const std::string &name) {
+#ifdef S21_POSIX_SHM
+  std::string path = SegmentName(name);
+  if (shm_unlink(path.c_str()) != 0 && errno != ENOENT) {
+    throw std::runtime_error(SystemError("Cannot unlink shared matrix", path));
+  }
+#else
+  (void)name;
+#endif
+}
+
+int S21SharedMatrix::GetRows() const { return header_->rows; }
+
+int S21SharedMatrix::GetCols() const { return header_->cols; }
+
+const std::string &S21SharedMatrix::GetName() const { return name_; }
+
+bool S21SharedMatrix::IsWritable() const { return writable_; }
+
+bool S21SharedMatrix::IsReady() const {
+  return header_->ready.load(std::memory_order_acquire) != 0;
+}
+
+uint64_t S21SharedMatrix::GetVersion() const {
+  return header_->version.load(std::memory_order_acquire);
+}
+
+const double *S21SharedMatrix::Data() const { return data_; }
+
+double *S21SharedMatrix::MutableData() {
+  if (!writable_) {
+    throw std::logic_error("Shared matrix is attached read-only.");
+  }
+  return data_;
+}
+
+bool S21SharedMatrix::IsConsistent(uint64_t version) const {
+  // Чтения данных не переносятся ниже повторной загрузки версии
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return version % 2 == 0 &&
+         header_->version.load(std::memory_order_relaxed) == version;
+}
+
+void S21SharedMatrix::BeginUpdate() {
+  MutableData();
+  // Писатель один, поэтому версию можно менять загрузкой и записью
+  uint64_t version = header_->version.load(std::memory_order_relaxed);
+  header_->ready.store(0, std::memory_order_relaxed);
+  if (version % 2 == 0) {
+    header_->version.store(version + 1, std::memory_order_relaxed);
+  }
+  // Нечетная версия становится видна раньше любой записи данных
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void S21SharedMatrix::MarkReady() {
+  MutableData();
+  uint64_t version = header_->version.load(std::memory_order_relaxed);
+  header_->version.store(version + (version % 2 == 0 ? 2 : 1),
+                         std::memory_order_release);
+  header_->ready.store(1, std::memory_order_release);
+}
+
+const double &S21SharedMatrix::operator()(int i, int j) const {
+  if (i < 0 || i >= GetRows() || j < 0 || j >= GetCols()) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  return data_[static_cast<size_t>(i) * GetCols() + j];
+}
+
+S21Matrix S21SharedMatrix::ToMatrix() const {
+  S21Matrix result(GetRows(), GetCols());
+  while (true) {
+    uint64_t version = GetVersion();
+    if (version % 2 == 0) {
+      for (int i = 0; i < GetRows(); i++) {
+        const double *row = data_ + static_cast<size_t>(i) * GetCols();
+        std::copy(row, row + GetCols(), &result(i, 0));
+      }
+      if (IsConsistent(version)) {
+        return result;
+      }
+    }
+    std::this_thread::yield();
+  }
+}
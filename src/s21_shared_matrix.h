@@ -0,0 +1,101 @@
+#ifndef SRC_S21_SHARED_MATRIX_H_
+#define SRC_S21_SHARED_MATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Матрица в именованном сегменте разделяемой памяти POSIX. Сегмент
+/// начинается с заголовка (сигнатура, размеры, версия, флаг готовности), за
+/// ним по строкам лежат элементы. Один процесс создает и заполняет сегмент,
+/// остальные подключаются к нему без копирования и сериализации.
+/// Сегмент живет, пока его не удалят через Unlink, даже если все процессы
+/// уже отключились
+class S21SharedMatrix {
+ public:
+  /// @brief Создает сегмент rows x cols для записи на месте. Читатели не
+  /// видят его, пока не вызван MarkReady
+  /// @param name имя сегмента; если нет ведущего '/', он добавляется
+  /// @throw std::invalid_argument неверные размеры
+  /// @throw std::runtime_error сегмент уже существует или ошибка ОС
+  static S21SharedMatrix Create(const std::string &name, int rows, int cols);
+
+  /// @brief Create, копирование matrix и MarkReady
+  static S21SharedMatrix Publish(const std::string &name,
+                                 const S21Matrix &matrix);
+
+  /// @brief Подключение только для чтения. Если сегмента еще нет или он не
+  /// готов, ожидает до timeout_ms миллисекунд
+  /// @throw std::runtime_error сегмент не появился вовремя или это не
+  /// матрица
+  static S21SharedMatrix Attach(const std::string &name, int timeout_ms = 0);
+
+  /// @brief Удаляет имя сегмента; подключенные процессы сохраняют доступ
+  static void Unlink(const std::string &name);
+
+  S21SharedMatrix(S21SharedMatrix &&other) noexcept;
+  S21SharedMatrix &operator=(S21SharedMatrix &&other) noexcept;
+  S21SharedMatrix(const S21SharedMatrix &other) = delete;
+  S21SharedMatrix &operator=(const S21SharedMatrix &other) = delete;
+  ~S21SharedMatrix();
+
+  int GetRows() const;
+  int GetCols() const;
+  const std::string &GetName() const;
+  bool IsWritable() const;
+
+  /// @brief Готовы ли данные
+  bool IsReady() const;
+
+  /// @brief Счетчик версий по схеме seqlock: нечетный, пока идет
+  /// обновление, и четный после MarkReady. Согласованное чтение на месте:
+  /// взять версию, прочитать данные и проверить IsConsistent; при false
+  /// повторить
+  uint64_t GetVersion() const;
+
+  /// @brief Версия четная и не изменилась с GetVersion, то есть прочитанные
+  /// после него данные не пересеклись с обновлением
+  bool IsConsistent(uint64_t version) const;
+
+  /// @brief Элементы по строкам, rows * cols чисел
+  const double *Data() const;
+
+  /// @brief Данные для записи
+  /// @throw std::logic_error матрица подключена только для чтения
+  double *MutableData();
+
+  /// @brief Снимает флаг готовности и делает версию нечетной перед
+  /// обновлением на месте
+  void BeginUpdate();
+
+  /// @brief Делает версию следующей четной и выставляет флаг готовности;
+  /// записи до вызова видны читателю, увидевшему флаг или новую версию
+  void MarkReady();
+
+  /// @brief Доступ к элементу без копирования
+  /// @throw std::out_of_range индекс вне матрицы
+  const double &operator()(int i, int j) const;
+
+  /// @brief Согласованная копия в обычную S21Matrix: копирование
+  /// повторяется, пока не пройдет без пересечения с обновлением, поэтому
+  /// ждет окончания начатого BeginUpdate
+  S21Matrix ToMatrix() const;
+
+ private:
+  struct Header;
+
+  S21SharedMatrix(const std::string &name, void *memory, size_t size,
+                  bool writable);
+  void Release();
+
+  std::string name_;
+  void *memory_;
+  size_t size_;
+  Header *header_;
+  double *data_;
+  bool writable_;
+};
+
+#endif  // SRC_S21_SHARED_MATRIX_H_
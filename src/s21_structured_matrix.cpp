@@ -0,0 +1,822 @@
+#include "s21_structured_matrix.h"
+
+#include <algorithm>
+
+namespace {
+
+void CheckSize(int size) {
+  if (size <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+}
+
+void CheckSquare(const S21Matrix &matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+}
+
+void CheckIndex(int size, int i, int j) {
+  if (i < 0 || j < 0 || i >= size || j >= size) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+}
+
+void CheckOutsideValue(double value) {
+  if (value != 0.0) {
+    throw std::invalid_argument("Element is outside of the matrix structure.");
+  }
+}
+
+void CheckSameSquare(int size, const S21Matrix &other) {
+  if (other.GetRows() != size || other.GetCols() != size) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+}
+
+void CheckMulRows(int size, const S21Matrix &other) {
+  if (other.GetRows() != size) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+}
+
+void CheckMulCols(const S21Matrix &other, int size) {
+  if (other.GetCols() != size) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+}
+
+void CheckNumber(double num) {
+  if (num != num) {
+    throw std::invalid_argument("Incorrect argument for multiplication.");
+  }
+}
+
+// Указатели на строки: строки S21Matrix лежат в памяти непрерывно
+double *Row(S21Matrix &matrix, int i) { return &matrix(i, 0); }
+const double *Row(const S21Matrix &matrix, int i) { return &matrix(i, 0); }
+
+// out += a * in по всей строке длины n
+void AddScaledRow(double *out, const double *in, double a, int n) {
+  for (int j = 0; j < n; j++) {
+    out[j] += a * in[j];
+  }
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// S21DiagonalMatrix
+
+S21DiagonalMatrix::S21DiagonalMatrix(int size) {
+  CheckSize(size);
+  diagonal_.assign(size, 0.0);
+}
+
+S21DiagonalMatrix::S21DiagonalMatrix(const S21Matrix &matrix) {
+  CheckSquare(matrix);
+  int n = matrix.GetRows();
+  diagonal_.resize(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (i != j) {
+        CheckOutsideValue(matrix(i, j));
+      }
+    }
+    diagonal_[i] = matrix(i, i);
+  }
+}
+
+int S21DiagonalMatrix::GetSize() const {
+  return static_cast<int>(diagonal_.size());
+}
+
+double S21DiagonalMatrix::GetElement(int i, int j) const {
+  CheckIndex(GetSize(), i, j);
+  return i == j ? diagonal_[i] : 0.0;
+}
+
+void S21DiagonalMatrix::SetElement(int i, int j, double value) {
+  CheckIndex(GetSize(), i, j);
+  if (i != j) {
+    CheckOutsideValue(value);
+    return;
+  }
+  diagonal_[i] = value;
+}
+
+S21Matrix S21DiagonalMatrix::ToMatrix() const {
+  S21Matrix result(GetSize(), GetSize());
+  for (int i = 0; i < GetSize(); i++) {
+    result(i, i) = diagonal_[i];
+  }
+  return result;
+}
+
+void S21DiagonalMatrix::SumMatrix(const S21DiagonalMatrix &other) {
+  if (GetSize() != other.GetSize()) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+  for (int i = 0; i < GetSize(); i++) {
+    diagonal_[i] += other.diagonal_[i];
+  }
+}
+
+void S21DiagonalMatrix::SubMatrix(const S21DiagonalMatrix &other) {
+  if (GetSize() != other.GetSize()) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+  for (int i = 0; i < GetSize(); i++) {
+    diagonal_[i] -= other.diagonal_[i];
+  }
+}
+
+void S21DiagonalMatrix::MulNumber(double num) {
+  CheckNumber(num);
+  for (double &value : diagonal_) {
+    value *= num;
+  }
+}
+
+void S21DiagonalMatrix::MulMatrix(const S21DiagonalMatrix &other) {
+  if (GetSize() != other.GetSize()) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  for (int i = 0; i < GetSize(); i++) {
+    diagonal_[i] *= other.diagonal_[i];
+  }
+}
+
+S21Matrix S21DiagonalMatrix::operator+(const S21Matrix &other) const {
+  CheckSameSquare(GetSize(), other);
+  S21Matrix result(other);
+  for (int i = 0; i < GetSize(); i++) {
+    result(i, i) += diagonal_[i];
+  }
+  return result;
+}
+
+S21Matrix S21DiagonalMatrix::operator-(const S21Matrix &other) const {
+  CheckSameSquare(GetSize(), other);
+  S21Matrix result(other * -1.0);
+  for (int i = 0; i < GetSize(); i++) {
+    result(i, i) += diagonal_[i];
+  }
+  return result;
+}
+
+S21Matrix S21DiagonalMatrix::operator*(const S21Matrix &other) const {
+  CheckMulRows(GetSize(), other);
+  int cols = other.GetCols();
+  S21Matrix result(GetSize(), cols);
+  for (int i = 0; i < GetSize(); i++) {
+    AddScaledRow(Row(result, i), Row(other, i), diagonal_[i], cols);
+  }
+  return result;
+}
+
+S21Matrix operator*(const S21Matrix &other, const S21DiagonalMatrix &diagonal) {
+  int n = diagonal.GetSize();
+  CheckMulCols(other, n);
+  S21Matrix result(other.GetRows(), n);
+  for (int i = 0; i < other.GetRows(); i++) {
+    const double *in = Row(other, i);
+    double *out = Row(result, i);
+    for (int j = 0; j < n; j++) {
+      out[j] = in[j] * diagonal.diagonal_[j];
+    }
+  }
+  return result;
+}
+
+double S21DiagonalMatrix::Determinant() const {
+  double determinant = 1.0;
+  for (double value : diagonal_) {
+    determinant *= value;
+  }
+  return determinant;
+}
+
+S21Matrix S21DiagonalMatrix::Solve(const S21Matrix &b) const {
+  CheckMulRows(GetSize(), b);
+  S21Matrix x(b);
+  for (int i = 0; i < GetSize(); i++) {
+    if (diagonal_[i] == 0.0) {
+      throw std::logic_error("Determinant equal to zero");
+    }
+    double *row = Row(x, i);
+    for (int j = 0; j < b.GetCols(); j++) {
+      row[j] /= diagonal_[i];
+    }
+  }
+  return x;
+}
+
+// ---------------------------------------------------------------------------
+// S21TriangularMatrix
+
+S21TriangularMatrix::S21TriangularMatrix(int size, bool upper)
+    : size_(size), upper_(upper) {
+  CheckSize(size);
+  values_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix &matrix, bool upper)
+    : size_(matrix.GetRows()), upper_(upper) {
+  CheckSquare(matrix);
+  values_.resize(static_cast<size_t>(size_) * (size_ + 1) / 2);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      if (Contains(i, j)) {
+        values_[Index(i, j)] = matrix(i, j);
+      } else {
+        CheckOutsideValue(matrix(i, j));
+      }
+    }
+  }
+}
+
+size_t S21TriangularMatrix::Index(int i, int j) const {
+  size_t row = static_cast<size_t>(i);
+  if (upper_) {
+    // Строка i начинается после строк длины n, n - 1, ..., n - i + 1
+    return row * size_ - row * (row - 1) / 2 + (j - i);
+  }
+  return row * (row + 1) / 2 + j;
+}
+
+bool S21TriangularMatrix::Contains(int i, int j) const {
+  return upper_ ? j >= i : j <= i;
+}
+
+void S21TriangularMatrix::CheckSameShape(
+    const S21TriangularMatrix &other) const {
+  if (size_ != other.size_ || upper_ != other.upper_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+}
+
+int S21TriangularMatrix::GetSize() const { return size_; }
+
+bool S21TriangularMatrix::IsUpper() const { return upper_; }
+
+double S21TriangularMatrix::GetElement(int i, int j) const {
+  CheckIndex(size_, i, j);
+  return Contains(i, j) ? values_[Index(i, j)] : 0.0;
+}
+
+void S21TriangularMatrix::SetElement(int i, int j, double value) {
+  CheckIndex(size_, i, j);
+  if (!Contains(i, j)) {
+    CheckOutsideValue(value);
+    return;
+  }
+  values_[Index(i, j)] = value;
+}
+
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    int begin = upper_ ? i : 0;
+    int end = upper_ ? size_ : i + 1;
+    std::copy(values_.begin() + Index(i, begin),
+              values_.begin() + Index(i, begin) + (end - begin),
+              Row(result, i) + begin);
+  }
+  return result;
+}
+
+void S21TriangularMatrix::SumMatrix(const S21TriangularMatrix &other) {
+  CheckSameShape(other);
+  for (size_t k = 0; k < values_.size(); k++) {
+    values_[k] += other.values_[k];
+  }
+}
+
+void S21TriangularMatrix::SubMatrix(const S21TriangularMatrix &other) {
+  CheckSameShape(other);
+  for (size_t k = 0; k < values_.size(); k++) {
+    values_[k] -= other.values_[k];
+  }
+}
+
+void S21TriangularMatrix::MulNumber(double num) {
+  CheckNumber(num);
+  for (double &value : values_) {
+    value *= num;
+  }
+}
+
+void S21TriangularMatrix::MulMatrix(const S21TriangularMatrix &other) {
+  if (size_ != other.size_ || upper_ != other.upper_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  // Строка i результата: сумма this(i, k) * (строка k other) по k из
+  // треугольника; строка k other лежит внутри треугольника строки i
+  std::vector<double> result(values_.size(), 0.0);
+  for (int i = 0; i < size_; i++) {
+    int k_begin = upper_ ? i : 0;
+    int k_end = upper_ ? size_ : i + 1;
+    for (int k = k_begin; k < k_end; k++) {
+      double a = values_[Index(i, k)];
+      if (a == 0.0) {
+        continue;
+      }
+      int j_begin = upper_ ? k : 0;
+      int j_end = upper_ ? size_ : k + 1;
+      AddScaledRow(result.data() + Index(i, j_begin),
+                   other.values_.data() + other.Index(k, j_begin), a,
+                   j_end - j_begin);
+    }
+  }
+  values_ = std::move(result);
+}
+
+S21Matrix S21TriangularMatrix::operator+(const S21Matrix &other) const {
+  CheckSameSquare(size_, other);
+  S21Matrix result(other);
+  for (int i = 0; i < size_; i++) {
+    int begin = upper_ ? i : 0;
+    int end = upper_ ? size_ : i + 1;
+    AddScaledRow(Row(result, i) + begin, values_.data() + Index(i, begin),
+                 1.0, end - begin);
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::operator-(const S21Matrix &other) const {
+  CheckSameSquare(size_, other);
+  S21Matrix result(other * -1.0);
+  for (int i = 0; i < size_; i++) {
+    int begin = upper_ ? i : 0;
+    int end = upper_ ? size_ : i + 1;
+    AddScaledRow(Row(result, i) + begin, values_.data() + Index(i, begin),
+                 1.0, end - begin);
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::operator*(const S21Matrix &other) const {
+  CheckMulRows(size_, other);
+  int cols = other.GetCols();
+  S21Matrix result(size_, cols);
+  for (int i = 0; i < size_; i++) {
+    double *out = Row(result, i);
+    int begin = upper_ ? i : 0;
+    int end = upper_ ? size_ : i + 1;
+    const double *row = values_.data() + Index(i, begin);
+    for (int k = begin; k < end; k++) {
+      AddScaledRow(out, Row(other, k), row[k - begin], cols);
+    }
+  }
+  return result;
+}
+
+S21Matrix operator*(const S21Matrix &other,
+                    const S21TriangularMatrix &triangular) {
+  int n = triangular.GetSize();
+  CheckMulCols(other, n);
+  S21Matrix result(other.GetRows(), n);
+  for (int r = 0; r < other.GetRows(); r++) {
+    const double *in = Row(other, r);
+    double *out = Row(result, r);
+    // Строка k треугольной матрицы непрерывна: (k..n-1) или (0..k)
+    for (int k = 0; k < n; k++) {
+      if (in[k] == 0.0) {
+        continue;
+      }
+      int begin = triangular.upper_ ? k : 0;
+      int end = triangular.upper_ ? n : k + 1;
+      AddScaledRow(out + begin,
+                   triangular.values_.data() + triangular.Index(k, begin),
+                   in[k], end - begin);
+    }
+  }
+  return result;
+}
+
+double S21TriangularMatrix::Determinant() const {
+  double determinant = 1.0;
+  for (int i = 0; i < size_; i++) {
+    determinant *= values_[Index(i, i)];
+  }
+  return determinant;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix &b) const {
+  CheckMulRows(size_, b);
+  int cols = b.GetCols();
+  S21Matrix x(b);
+  for (int step = 0; step < size_; step++) {
+    // Нижняя - прямая подстановка сверху, верхняя - обратная снизу
+    int i = upper_ ? size_ - 1 - step : step;
+    int begin = upper_ ? i + 1 : 0;
+    int end = upper_ ? size_ : i;
+    double *out = Row(x, i);
+    for (int k = begin; k < end; k++) {
+      AddScaledRow(out, Row(x, k), -values_[Index(i, k)], cols);
+    }
+    double pivot = values_[Index(i, i)];
+    if (pivot == 0.0) {
+      throw std::logic_error("Determinant equal to zero");
+    }
+    for (int j = 0; j < cols; j++) {
+      out[j] /= pivot;
+    }
+  }
+  return x;
+}
+
+// ---------------------------------------------------------------------------
+// S21SymmetricMatrix
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  CheckSize(size);
+  values_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix &matrix)
+    : size_(matrix.GetRows()) {
+  CheckSquare(matrix);
+  values_.resize(static_cast<size_t>(size_) * (size_ + 1) / 2);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j <= i; j++) {
+      if (matrix(i, j) != matrix(j, i)) {
+        throw std::invalid_argument("Matrix is not symmetric.");
+      }
+      values_[Index(i, j)] = matrix(i, j);
+    }
+  }
+}
+
+S21SymmetricMatrix S21SymmetricMatrix::Gram(const S21Matrix &a) {
+  int n = a.GetCols();
+  S21SymmetricMatrix result(n);
+  // Строки a обходятся по очереди: каждая добавляет свое внешнее
+  // произведение в нижний треугольник
+  for (int r = 0; r < a.GetRows(); r++) {
+    const double *row = Row(a, r);
+    for (int i = 0; i < n; i++) {
+      if (row[i] != 0.0) {
+        AddScaledRow(result.values_.data() + result.Index(i, 0), row, row[i],
+                     i + 1);
+      }
+    }
+  }
+  return result;
+}
+
+size_t S21SymmetricMatrix::Index(int i, int j) const {
+  if (j > i) {
+    std::swap(i, j);
+  }
+  return static_cast<size_t>(i) * (i + 1) / 2 + j;
+}
+
+void S21SymmetricMatrix::CheckSameSize(const S21SymmetricMatrix &other) const {
+  if (size_ != other.size_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+}
+
+int S21SymmetricMatrix::GetSize() const { return size_; }
+
+double S21SymmetricMatrix::GetElement(int i, int j) const {
+  CheckIndex(size_, i, j);
+  return values_[Index(i, j)];
+}
+
+void S21SymmetricMatrix::SetElement(int i, int j, double value) {
+  CheckIndex(size_, i, j);
+  values_[Index(i, j)] = value;
+}
+
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    const double *row = values_.data() + Index(i, 0);
+    for (int j = 0; j <= i; j++) {
+      result(i, j) = row[j];
+      result(j, i) = row[j];
+    }
+  }
+  return result;
+}
+
+void S21SymmetricMatrix::SumMatrix(const S21SymmetricMatrix &other) {
+  CheckSameSize(other);
+  for (size_t k = 0; k < values_.size(); k++) {
+    values_[k] += other.values_[k];
+  }
+}
+
+void S21SymmetricMatrix::SubMatrix(const S21SymmetricMatrix &other) {
+  CheckSameSize(other);
+  for (size_t k = 0; k < values_.size(); k++) {
+    values_[k] -= other.values_[k];
+  }
+}
+
+void S21SymmetricMatrix::MulNumber(double num) {
+  CheckNumber(num);
+  for (double &value : values_) {
+    value *= num;
+  }
+}
+
+S21Matrix S21SymmetricMatrix::operator+(const S21Matrix &other) const {
+  CheckSameSquare(size_, other);
+  S21Matrix result(other);
+  for (int i = 0; i < size_; i++) {
+    const double *row = values_.data() + Index(i, 0);
+    for (int j = 0; j < i; j++) {
+      result(i, j) += row[j];
+      result(j, i) += row[j];
+    }
+    result(i, i) += row[i];
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::operator-(const S21Matrix &other) const {
+  return *this + other * -1.0;
+}
+
+S21Matrix S21SymmetricMatrix::operator*(const S21Matrix &other) const {
+  CheckMulRows(size_, other);
+  int cols = other.GetCols();
+  S21Matrix result(size_, cols);
+  for (int i = 0; i < size_; i++) {
+    const double *row = values_.data() + Index(i, 0);
+    double *out_i = Row(result, i);
+    const double *in_i = Row(other, i);
+    for (int j = 0; j < i; j++) {
+      if (row[j] != 0.0) {
+        AddScaledRow(out_i, Row(other, j), row[j], cols);
+        AddScaledRow(Row(result, j), in_i, row[j], cols);
+      }
+    }
+    AddScaledRow(out_i, in_i, row[i], cols);
+  }
+  return result;
+}
+
+S21Matrix operator*(const S21Matrix &other,
+                    const S21SymmetricMatrix &symmetric) {
+  int n = symmetric.GetSize();
+  CheckMulCols(other, n);
+  S21Matrix result(other.GetRows(), n);
+  for (int r = 0; r < other.GetRows(); r++) {
+    const double *in = Row(other, r);
+    double *out = Row(result, r);
+    for (int i = 0; i < n; i++) {
+      const double *row = symmetric.values_.data() + symmetric.Index(i, 0);
+      // (other * s)(r, i) по строке i треугольника и вклад s(i, j) в
+      // столбцы j < i
+      double sum = in[i] * row[i];
+      for (int j = 0; j < i; j++) {
+        sum += in[j] * row[j];
+        out[j] += in[i] * row[j];
+      }
+      out[i] += sum;
+    }
+  }
+  return result;
+}
+
+// ---------------------------------------------------------------------------
+// S21BandMatrix
+
+S21BandMatrix::S21BandMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  CheckSize(size);
+  if (lower < 0 || upper < 0) {
+    throw std::invalid_argument("Invalid matrix bandwidth.");
+  }
+  values_.assign(static_cast<size_t>(size) * Width(), 0.0);
+}
+
+S21BandMatrix::S21BandMatrix(const S21Matrix &matrix, int lower, int upper)
+    : S21BandMatrix(matrix.GetRows(), lower, upper) {
+  CheckSquare(matrix);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      if (Contains(i, j)) {
+        values_[static_cast<size_t>(i) * Width() + (j - i + lower_)] =
+            matrix(i, j);
+      } else {
+        CheckOutsideValue(matrix(i, j));
+      }
+    }
+  }
+}
+
+int S21BandMatrix::Width() const { return lower_ + upper_ + 1; }
+
+bool S21BandMatrix::Contains(int i, int j) const {
+  return j - i >= -lower_ && j - i <= upper_;
+}
+
+void S21BandMatrix::CheckSameShape(const S21BandMatrix &other) const {
+  if (size_ != other.size_ || lower_ != other.lower_ ||
+      upper_ != other.upper_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+}
+
+int S21BandMatrix::GetSize() const { return size_; }
+
+int S21BandMatrix::GetLower() const { return lower_; }
+
+int S21BandMatrix::GetUpper() const { return upper_; }
+
+double S21BandMatrix::GetElement(int i, int j) const {
+  CheckIndex(size_, i, j);
+  if (!Contains(i, j)) {
+    return 0.0;
+  }
+  return values_[static_cast<size_t>(i) * Width() + (j - i + lower_)];
+}
+
+void S21BandMatrix::SetElement(int i, int j, double value) {
+  CheckIndex(size_, i, j);
+  if (!Contains(i, j)) {
+    CheckOutsideValue(value);
+    return;
+  }
+  values_[static_cast<size_t>(i) * Width() + (j - i + lower_)] = value;
+}
+
+S21Matrix S21BandMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  return *this + result;
+}
+
+void S21BandMatrix::SumMatrix(const S21BandMatrix &other) {
+  CheckSameShape(other);
+  for (size_t k = 0; k < values_.size(); k++) {
+    values_[k] += other.values_[k];
+  }
+}
+
+void S21BandMatrix::SubMatrix(const S21BandMatrix &other) {
+  CheckSameShape(other);
+  for (size_t k = 0; k < values_.size(); k++) {
+    values_[k] -= other.values_[k];
+  }
+}
+
+void S21BandMatrix::MulNumber(double num) {
+  CheckNumber(num);
+  for (double &value : values_) {
+    value *= num;
+  }
+}
+
+S21Matrix S21BandMatrix::operator+(const S21Matrix &other) const {
+  CheckSameSquare(size_, other);
+  S21Matrix result(other);
+  for (int i = 0; i < size_; i++) {
+    int begin = std::max(0, i - lower_);
+    int end = std::min(size_, i + upper_ + 1);
+    AddScaledRow(Row(result, i) + begin,
+                 values_.data() + static_cast<size_t>(i) * Width() +
+                     (begin - i + lower_),
+                 1.0, end - begin);
+  }
+  return result;
+}
+
+S21Matrix S21BandMatrix::operator-(const S21Matrix &other) const {
+  return *this + other * -1.0;
+}
+
+S21Matrix S21BandMatrix::operator*(const S21Matrix &other) const {
+  CheckMulRows(size_, other);
+  int cols = other.GetCols();
+  S21Matrix result(size_, cols);
+  for (int i = 0; i < size_; i++) {
+    const double *row = values_.data() + static_cast<size_t>(i) * Width();
+    double *out = Row(result, i);
+    int begin = std::max(0, i - lower_);
+    int end = std::min(size_, i + upper_ + 1);
+    for (int k = begin; k < end; k++) {
+      AddScaledRow(out, Row(other, k), row[k - i + lower_], cols);
+    }
+  }
+  return result;
+}
+
+S21Matrix operator*(const S21Matrix &other, const S21BandMatrix &band) {
+  int n = band.size_;
+  CheckMulCols(other, n);
+  S21Matrix result(other.GetRows(), n);
+  for (int r = 0; r < other.GetRows(); r++) {
+    const double *in = Row(other, r);
+    double *out = Row(result, r);
+    for (int k = 0; k < n; k++) {
+      if (in[k] == 0.0) {
+        continue;
+      }
+      int begin = std::max(0, k - band.lower_);
+      int end = std::min(n, k + band.upper_ + 1);
+      AddScaledRow(out + begin,
+                   band.values_.data() + static_cast<size_t>(k) * band.Width() +
+                       (begin - k + band.lower_),
+                   in[k], end - begin);
+    }
+  }
+  return result;
+}
+
+bool S21BandMatrix::Eliminate(S21Matrix *rhs, double *determinant) const {
+  // Перестановки строк расширяют верхнюю ленту U до lower + upper, поэтому
+  // рабочая строка i хранит столбцы i - lower .. i + lower + upper
+  int width = 2 * lower_ + upper_ + 1;
+  int reach = lower_ + upper_;
+  std::vector<double> work(static_cast<size_t>(size_) * width, 0.0);
+  for (int i = 0; i < size_; i++) {
+    std::copy(values_.begin() + static_cast<size_t>(i) * Width(),
+              values_.begin() + static_cast<size_t>(i + 1) * Width(),
+              work.begin() + static_cast<size_t>(i) * width);
+  }
+  auto at = [&](int i, int j) -> double & {
+    return work[static_cast<size_t>(i) * width + (j - i + lower_)];
+  };
+  int cols = rhs != nullptr ? rhs->GetCols() : 0;
+  *determinant = 1.0;
+  for (int k = 0; k < size_; k++) {
+    int last = std::min(size_ - 1, k + lower_);
+    int pivot = k;
+    for (int i = k + 1; i <= last; i++) {
+      if (std::abs(at(i, k)) > std::abs(at(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (at(pivot, k) == 0.0) {
+      *determinant = 0.0;
+      return false;
+    }
+    int end = std::min(size_ - 1, k + reach);
+    if (pivot != k) {
+      for (int j = k; j <= end; j++) {
+        std::swap(at(k, j), at(pivot, j));
+      }
+      if (rhs != nullptr) {
+        std::swap_ranges(Row(*rhs, k), Row(*rhs, k) + cols, Row(*rhs, pivot));
+      }
+      *determinant = -*determinant;
+    }
+    *determinant *= at(k, k);
+    for (int i = k + 1; i <= last; i++) {
+      double factor = at(i, k) / at(k, k);
+      if (factor == 0.0) {
+        continue;
+      }
+      for (int j = k + 1; j <= end; j++) {
+        at(i, j) -= factor * at(k, j);
+      }
+      if (rhs != nullptr) {
+        AddScaledRow(Row(*rhs, i), Row(*rhs, k), -factor, cols);
+      }
+    }
+  }
+  for (int i = size_ - 1; rhs != nullptr && i >= 0; i--) {
+    double *out = Row(*rhs, i);
+    int end = std::min(size_ - 1, i + reach);
+    for (int j = i + 1; j <= end; j++) {
+      AddScaledRow(out, Row(*rhs, j), -at(i, j), cols);
+    }
+    for (int c = 0; c < cols; c++) {
+      out[c] /= at(i, i);
+    }
+  }
+  return true;
+}
+
+double S21BandMatrix::Determinant() const {
+  double determinant = 0.0;
+  Eliminate(nullptr, &determinant);
+  return determinant;
+}
+
+S21Matrix S21BandMatrix::Solve(const S21Matrix &b) const {
+  CheckMulRows(size_, b);
+  S21Matrix x(b);
+  double determinant = 0.0;
+  if (!Eliminate(&x, &determinant)) {
+    throw std::logic_error("Determinant equal to zero");
+  }
+  return x;
+}
@@ -0,0 +1,228 @@
+#ifndef SRC_S21_STRUCTURED_MATRIX_H_
+#define SRC_S21_STRUCTURED_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Квадратные матрицы специальной структуры. Хранятся только элементы,
+// которые могут быть ненулевыми, операции обходят только их. Элементы вне
+// структуры читаются как ноль, записать туда можно только ноль. Конструктор
+// из S21Matrix проверяет, что матрица имеет нужную структуру
+
+/// @brief Диагональная матрица, n элементов
+class S21DiagonalMatrix {
+ public:
+  /// @brief Нулевая диагональная матрица
+  /// @param size размер матрицы
+  explicit S21DiagonalMatrix(int size);
+
+  /// @brief Диагональ квадратной матрицы, остальные элементы должны быть 0
+  explicit S21DiagonalMatrix(const S21Matrix &matrix);
+
+  int GetSize() const;
+  double GetElement(int i, int j) const;
+  void SetElement(int i, int j, double value);
+
+  /// @brief Полная матрица с той же диагональю
+  S21Matrix ToMatrix() const;
+
+  void SumMatrix(const S21DiagonalMatrix &other);
+  void SubMatrix(const S21DiagonalMatrix &other);
+  void MulNumber(double num);
+
+  /// @brief Произведение диагональных матриц за O(n)
+  void MulMatrix(const S21DiagonalMatrix &other);
+
+  /// @brief Сумма и разность с полной матрицей, меняется только диагональ
+  S21Matrix operator+(const S21Matrix &other) const;
+  S21Matrix operator-(const S21Matrix &other) const;
+
+  /// @brief this * other: масштабирование строк other за O(n * cols)
+  S21Matrix operator*(const S21Matrix &other) const;
+
+  /// @brief Произведение диагонали
+  double Determinant() const;
+
+  /// @brief Решение this * x = b за O(n * k)
+  S21Matrix Solve(const S21Matrix &b) const;
+
+ private:
+  friend S21Matrix operator*(const S21Matrix &other,
+                              const S21DiagonalMatrix &diagonal);
+
+  std::vector<double> diagonal_;
+};
+
+/// @brief other * diagonal: масштабирование столбцов other
+S21Matrix operator*(const S21Matrix &other, const S21DiagonalMatrix &diagonal);
+
+/// @brief Нижняя или верхняя треугольная матрица, n * (n + 1) / 2 элементов
+/// по строкам
+class S21TriangularMatrix {
+ public:
+  /// @brief Нулевая треугольная матрица
+  /// @param size размер матрицы
+  /// @param upper true - верхняя, false - нижняя
+  S21TriangularMatrix(int size, bool upper);
+
+  /// @brief Треугольник квадратной матрицы, элементы по другую сторону от
+  /// диагонали должны быть 0
+  S21TriangularMatrix(const S21Matrix &matrix, bool upper);
+
+  int GetSize() const;
+  bool IsUpper() const;
+  double GetElement(int i, int j) const;
+  void SetElement(int i, int j, double value);
+  S21Matrix ToMatrix() const;
+
+  void SumMatrix(const S21TriangularMatrix &other);
+  void SubMatrix(const S21TriangularMatrix &other);
+  void MulNumber(double num);
+
+  /// @brief Произведение треугольных матриц одного вида, около n^3 / 6
+  /// умножений вместо n^3
+  void MulMatrix(const S21TriangularMatrix &other);
+
+  S21Matrix operator+(const S21Matrix &other) const;
+  S21Matrix operator-(const S21Matrix &other) const;
+
+  /// @brief this * other, обходятся только хранимые элементы
+  S21Matrix operator*(const S21Matrix &other) const;
+
+  /// @brief Произведение диагонали
+  double Determinant() const;
+
+  /// @brief Решение this * x = b прямой или обратной подстановкой за
+  /// O(n^2 * k)
+  S21Matrix Solve(const S21Matrix &b) const;
+
+ private:
+  friend S21Matrix operator*(const S21Matrix &other,
+                              const S21TriangularMatrix &triangular);
+
+  int size_;
+  bool upper_;
+  std::vector<double> values_;
+
+  /// @brief Позиция элемента (i, j) из треугольника в values_
+  size_t Index(int i, int j) const;
+  bool Contains(int i, int j) const;
+  void CheckSameShape(const S21TriangularMatrix &other) const;
+};
+
+S21Matrix operator*(const S21Matrix &other,
+                    const S21TriangularMatrix &triangular);
+
+/// @brief Симметричная матрица, хранится нижний треугольник по строкам
+class S21SymmetricMatrix {
+ public:
+  /// @brief Нулевая симметричная матрица
+  /// @param size размер матрицы
+  explicit S21SymmetricMatrix(int size);
+
+  /// @brief Нижний треугольник квадратной матрицы, матрица должна быть
+  /// симметричной
+  explicit S21SymmetricMatrix(const S21Matrix &matrix);
+
+  /// @brief Матрица Грама a^T * a: считается только нижний треугольник,
+  /// вдвое меньше умножений, чем у полного произведения
+  /// @param a матрица (m x n)
+  /// @return симметричная матрица (n x n)
+  static S21SymmetricMatrix Gram(const S21Matrix &a);
+
+  int GetSize() const;
+  double GetElement(int i, int j) const;
+
+  /// @brief Изменяет элементы (i, j) и (j, i)
+  void SetElement(int i, int j, double value);
+  S21Matrix ToMatrix() const;
+
+  void SumMatrix(const S21SymmetricMatrix &other);
+  void SubMatrix(const S21SymmetricMatrix &other);
+  void MulNumber(double num);
+
+  S21Matrix operator+(const S21Matrix &other) const;
+  S21Matrix operator-(const S21Matrix &other) const;
+
+  /// @brief this * other: каждый хранимый элемент вне диагонали
+  /// используется дважды, читается половина матрицы
+  S21Matrix operator*(const S21Matrix &other) const;
+
+ private:
+  friend S21Matrix operator*(const S21Matrix &other,
+                              const S21SymmetricMatrix &symmetric);
+
+  int size_;
+  std::vector<double> values_;
+
+  size_t Index(int i, int j) const;
+  void CheckSameSize(const S21SymmetricMatrix &other) const;
+};
+
+S21Matrix operator*(const S21Matrix &other,
+                    const S21SymmetricMatrix &symmetric);
+
+/// @brief Ленточная матрица: ненулевые только элементы с
+/// -lower <= j - i <= upper. Каждая строка хранит lower + upper + 1
+/// элементов, трехдиагональная матрица - частный случай (1, 1)
+class S21BandMatrix {
+ public:
+  /// @brief Нулевая ленточная матрица
+  /// @param size размер матрицы
+  /// @param lower кол-во диагоналей под главной
+  /// @param upper кол-во диагоналей над главной
+  S21BandMatrix(int size, int lower, int upper);
+
+  /// @brief Лента квадратной матрицы, элементы вне ленты должны быть 0
+  S21BandMatrix(const S21Matrix &matrix, int lower, int upper);
+
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+  double GetElement(int i, int j) const;
+  void SetElement(int i, int j, double value);
+  S21Matrix ToMatrix() const;
+
+  void SumMatrix(const S21BandMatrix &other);
+  void SubMatrix(const S21BandMatrix &other);
+  void MulNumber(double num);
+
+  S21Matrix operator+(const S21Matrix &other) const;
+  S21Matrix operator-(const S21Matrix &other) const;
+
+  /// @brief this * other за O(n * (lower + upper) * cols)
+  S21Matrix operator*(const S21Matrix &other) const;
+
+  /// @brief Определитель ленточным исключением Гаусса
+  double Determinant() const;
+
+  /// @brief Решение this * x = b ленточным LU-разложением с выбором
+  /// главного элемента за O(n * lower * (lower + upper)) и O(n * (lower +
+  /// upper)) на каждый столбец правой части
+  S21Matrix Solve(const S21Matrix &b) const;
+
+ private:
+  friend S21Matrix operator*(const S21Matrix &other,
+                              const S21BandMatrix &band);
+
+  int size_;
+  int lower_;
+  int upper_;
+  std::vector<double> values_;
+
+  int Width() const;
+  bool Contains(int i, int j) const;
+  void CheckSameShape(const S21BandMatrix &other) const;
+
+  /// @brief Исключение Гаусса по ленте с выбором главного элемента
+  /// @param rhs если не nullptr, правая часть заменяется решением
+  /// @param determinant сюда записывается определитель
+  /// @return false, если матрица вырождена
+  bool Eliminate(S21Matrix *rhs, double *determinant) const;
+};
+
+S21Matrix operator*(const S21Matrix &other, const S21BandMatrix &band);
+
+#endif  // SRC_S21_STRUCTURED_MATRIX_H_
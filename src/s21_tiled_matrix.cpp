@@ -0,0 +1,676 @@
+#include "s21_tiled_matrix.h"
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Файл с плитками и LRU-кэш над ним. Плитка, выданная вычислениям,
+// закреплена и не вытесняется. Фоновый поток читает плитки из очереди
+// предвыборки, пока вычисления работают с уже загруженными
+class S21TiledMatrix::TileStore {
+ public:
+  // Закрепленная плитка, открепляется деструктором
+  class Handle {
+   public:
+    Handle(TileStore *store, int key, double *data)
+        : store_(store), key_(key), data_(data) {}
+    Handle(Handle &&other)
+        : store_(other.store_), key_(other.key_), data_(other.data_) {
+      other.store_ = nullptr;
+    }
+    Handle(const Handle &other) = delete;
+    Handle &operator=(const Handle &other) = delete;
+    Handle &operator=(Handle &&other) = delete;
+    ~Handle() {
+      if (store_ != nullptr) {
+        store_->Release(key_);
+      }
+    }
+    double *Data() const { return data_; }
+
+   private:
+    TileStore *store_;
+    int key_;
+    double *data_;
+  };
+
+  TileStore(const std::string &path, Storage storage, int tile_rows,
+            int tile_cols, int tile_size, int capacity)
+      : path_(path),
+        tile_rows_(tile_rows),
+        tile_cols_(tile_cols),
+        tile_size_(tile_size),
+        capacity_(static_cast<size_t>(capacity)) {
+    fd_ = Open(storage);
+    if (fd_ < 0) {
+      throw std::runtime_error("Cannot create matrix storage file.");
+    }
+    off_t size = static_cast<off_t>(TileBytes()) * tile_rows * tile_cols;
+    if (ftruncate(fd_, size) != 0) {
+      close(fd_);
+      if (!path_.empty()) {
+        unlink(path_.c_str());
+      }
+      throw std::runtime_error("Cannot allocate matrix storage file.");
+    }
+    prefetcher_ = std::thread(&TileStore::PrefetchLoop, this);
+  }
+
+  TileStore(const TileStore &other) = delete;
+  TileStore &operator=(const TileStore &other) = delete;
+
+  ~TileStore() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_.notify_all();
+    prefetcher_.join();
+    close(fd_);
+    if (!path_.empty()) {
+      unlink(path_.c_str());
+    }
+  }
+
+  int TileRows() const { return tile_rows_; }
+  int TileCols() const { return tile_cols_; }
+  int Capacity() const { return static_cast<int>(capacity_); }
+  const std::string &Path() const { return path_; }
+
+  void Rename(const std::string &path) {
+    if (std::rename(path_.c_str(), path.c_str()) != 0) {
+      throw std::runtime_error("Cannot rename matrix storage file.");
+    }
+    path_ = path;
+  }
+
+  Handle Acquire(int ti, int tj, bool write) {
+    int key = Key(ti, tj);
+    std::unique_lock<std::mutex> lock(mutex_);
+    Entry &entry = Pin(lock, key);
+    if (write) {
+      entry.dirty = true;
+    }
+    return Handle(this, key, entry.data.data());
+  }
+
+  void Prefetch(int ti, int tj) {
+    int key = Key(ti, tj);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (entries_.count(key) != 0) {
+        return;
+      }
+      queue_.push_back(key);
+    }
+    work_.notify_one();
+  }
+
+  void Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &item : entries_) {
+      if (item.second.dirty && !item.second.loading) {
+        WriteTile(item.first, item.second.data.data());
+        item.second.dirty = false;
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    std::vector<double> data;
+    std::list<int>::iterator lru;
+    int pins = 0;
+    bool dirty = false;
+    bool loading = false;
+    bool failed = false;
+  };
+
+  // Временные файлы создаются через mkstemp: имя уникально, а чужие файлы
+  // рядом с path не открываются и не обрезаются. У удаленного файла path_
+  // пустой
+  int Open(Storage storage) {
+    if (storage == Storage::kPath) {
+      return open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    }
+    std::string name = path_ + ".XXXXXX";
+    int fd = mkstemp(&name[0]);
+    if (fd >= 0 && storage == Storage::kUnlinked) {
+      unlink(name.c_str());
+      name.clear();
+    }
+    path_ = name;
+    return fd;
+  }
+
+  size_t TileBytes() const {
+    return sizeof(double) * static_cast<size_t>(tile_size_) * tile_size_;
+  }
+
+  int Key(int ti, int tj) const { return ti * tile_cols_ + tj; }
+
+  // Закрепляет плитку, при необходимости читая ее из файла. Чтение идет без
+  // блокировки, чтобы другой поток мог в это время работать с кэшем
+  Entry &Pin(std::unique_lock<std::mutex> &lock, int key) {
+    auto found = entries_.find(key);
+    if (found != entries_.end()) {
+      Entry &entry = found->second;
+      entry.pins++;
+      loaded_.wait(lock, [&entry] { return !entry.loading; });
+      if (entry.failed) {
+        Unpin(key);
+        throw std::runtime_error("Cannot read matrix storage file.");
+      }
+      lru_.splice(lru_.begin(), lru_, entry.lru);
+      return entry;
+    }
+    Entry &entry = entries_[key];
+    entry.data.resize(static_cast<size_t>(tile_size_) * tile_size_);
+    entry.pins = 1;
+    entry.loading = true;
+    lru_.push_front(key);
+    entry.lru = lru_.begin();
+    lock.unlock();
+    bool ok = ReadTile(key, entry.data.data());
+    lock.lock();
+    entry.loading = false;
+    loaded_.notify_all();
+    if (!ok) {
+      // Ожидающие эту плитку потоки увидят ошибку и открепят ее сами
+      entry.failed = true;
+      Unpin(key);
+      throw std::runtime_error("Cannot read matrix storage file.");
+    }
+    // Вытеснение пишет измененные плитки и может бросить исключение: здесь
+    // оно дойдет до вызывающего, а не до деструктора Handle
+    try {
+      EvictLocked();
+    } catch (...) {
+      entry.pins--;
+      throw;
+    }
+    return entry;
+  }
+
+  // Открепляет плитку, не прочитанная плитка удаляется последним владельцем
+  void Unpin(int key) {
+    Entry &entry = entries_[key];
+    entry.pins--;
+    if (entry.failed && entry.pins == 0) {
+      lru_.erase(entry.lru);
+      entries_.erase(key);
+    }
+  }
+
+  // Только открепляет: вызывается из деструктора Handle и не должен бросать.
+  // Лишние плитки вытесняются при следующем Pin
+  void Release(int key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key].pins--;
+  }
+
+  // Вытесняет давно не использованные незакрепленные плитки. Если запись не
+  // удалась, плитка остается в кэше измененной
+  void EvictLocked() {
+    auto it = lru_.end();
+    while (entries_.size() > capacity_ && it != lru_.begin()) {
+      --it;
+      Entry &entry = entries_[*it];
+      if (entry.pins > 0 || entry.loading || entry.failed) {
+        continue;
+      }
+      if (entry.dirty) {
+        WriteTile(*it, entry.data.data());
+      }
+      int key = *it;
+      it = lru_.erase(it);
+      entries_.erase(key);
+    }
+  }
+
+  bool ReadTile(int key, double *data) const {
+    char *buffer = reinterpret_cast<char *>(data);
+    size_t left = TileBytes();
+    off_t offset = static_cast<off_t>(TileBytes()) * key;
+    while (left > 0) {
+      ssize_t done = pread(fd_, buffer, left, offset);
+      if (done <= 0) {
+        return false;
+      }
+      buffer += done;
+      offset += done;
+      left -= static_cast<size_t>(done);
+    }
+    return true;
+  }
+
+  void WriteTile(int key, const double *data) const {
+    const char *buffer = reinterpret_cast<const char *>(data);
+    size_t left = TileBytes();
+    off_t offset = static_cast<off_t>(TileBytes()) * key;
+    while (left > 0) {
+      ssize_t done = pwrite(fd_, buffer, left, offset);
+      if (done <= 0) {
+        throw std::runtime_error("Cannot write matrix storage file.");
+      }
+      buffer += done;
+      offset += done;
+      left -= static_cast<size_t>(done);
+    }
+  }
+
+  void PrefetchLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      work_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (stop_) {
+        return;
+      }
+      int key = queue_.front();
+      queue_.pop_front();
+      if (entries_.count(key) != 0) {
+        continue;
+      }
+      try {
+        Entry &entry = Pin(lock, key);
+        entry.pins--;
+      } catch (const std::exception &) {
+        // Ошибку чтения или записи получит поток вычислений при обычном
+        // запросе плитки или при Flush
+      }
+    }
+  }
+
+  int fd_;
+  std::string path_;
+  int tile_rows_;
+  int tile_cols_;
+  int tile_size_;
+  size_t capacity_;
+  std::mutex mutex_;
+  std::condition_variable loaded_;
+  std::condition_variable work_;
+  std::unordered_map<int, Entry> entries_;
+  std::list<int> lru_;
+  std::deque<int> queue_;
+  bool stop_ = false;
+  std::thread prefetcher_;
+};
+
+namespace {
+
+// Какую часть кэша можно занять предвыборкой, не вытесняя рабочие плитки
+constexpr int kPrefetchShare = 4;
+
+int TileCount(int size, int tile_size) {
+  return (size + tile_size - 1) / tile_size;
+}
+
+}  // namespace
+
+S21TiledMatrix::S21TiledMatrix(const std::string &path, int rows, int cols,
+                               int tile_size, int cache_tiles)
+    : S21TiledMatrix(path, Storage::kPath, rows, cols, tile_size,
+                     cache_tiles) {}
+
+S21TiledMatrix::S21TiledMatrix(const std::string &path, Storage storage,
+                               int rows, int cols, int tile_size,
+                               int cache_tiles)
+    : rows_(rows), cols_(cols), tile_size_(tile_size) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument(
+        "Error: Invalid matrix dimensions, rows or cols <= 0");
+  }
+  if (tile_size <= 0 || cache_tiles < 4) {
+    throw std::invalid_argument("Invalid tile size or cache size.");
+  }
+  store_ = std::make_unique<TileStore>(
+      path, storage, TileCount(rows, tile_size), TileCount(cols, tile_size),
+      tile_size, cache_tiles);
+}
+
+S21TiledMatrix::S21TiledMatrix(const S21Matrix &matrix, const std::string &path,
+                               int tile_size, int cache_tiles)
+    : S21TiledMatrix(path, matrix.GetRows(), matrix.GetCols(), tile_size,
+                     cache_tiles) {
+  for (int ti = 0; ti < store_->TileRows(); ti++) {
+    for (int tj = 0; tj < store_->TileCols(); tj++) {
+      TileStore::Handle tile = store_->Acquire(ti, tj, true);
+      int row_end = std::min(rows_, (ti + 1) * tile_size_);
+      int col_end = std::min(cols_, (tj + 1) * tile_size_);
+      for (int i = ti * tile_size_; i < row_end; i++) {
+        double *out = tile.Data() + (i - ti * tile_size_) * tile_size_;
+        for (int j = tj * tile_size_; j < col_end; j++) {
+          out[j - tj * tile_size_] = matrix(i, j);
+        }
+      }
+    }
+  }
+}
+
+S21TiledMatrix::S21TiledMatrix(S21TiledMatrix &&other) = default;
+
+S21TiledMatrix &S21TiledMatrix::operator=(S21TiledMatrix &&other) = default;
+
+S21TiledMatrix::~S21TiledMatrix() = default;
+
+int S21TiledMatrix::GetRows() const { return rows_; }
+
+int S21TiledMatrix::GetCols() const { return cols_; }
+
+int S21TiledMatrix::GetTileSize() const { return tile_size_; }
+
+double S21TiledMatrix::GetElement(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  TileStore::Handle tile =
+      store_->Acquire(row / tile_size_, col / tile_size_, false);
+  return tile.Data()[(row % tile_size_) * tile_size_ + col % tile_size_];
+}
+
+void S21TiledMatrix::SetElement(int row, int col, double value) {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+    throw std::out_of_range("Invalid row or column index.");
+  }
+  TileStore::Handle tile =
+      store_->Acquire(row / tile_size_, col / tile_size_, true);
+  tile.Data()[(row % tile_size_) * tile_size_ + col % tile_size_] = value;
+}
+
+S21Matrix S21TiledMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  for (int ti = 0; ti < store_->TileRows(); ti++) {
+    for (int tj = 0; tj < store_->TileCols(); tj++) {
+      TileStore::Handle tile = store_->Acquire(ti, tj, false);
+      int row_end = std::min(rows_, (ti + 1) * tile_size_);
+      int col_end = std::min(cols_, (tj + 1) * tile_size_);
+      for (int i = ti * tile_size_; i < row_end; i++) {
+        const double *in = tile.Data() + (i - ti * tile_size_) * tile_size_;
+        for (int j = tj * tile_size_; j < col_end; j++) {
+          result(i, j) = in[j - tj * tile_size_];
+        }
+      }
+    }
+  }
+  return result;
+}
+
+void S21TiledMatrix::SumMatrix(const S21TiledMatrix &other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_ ||
+      tile_size_ != other.tile_size_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+  int tiles = store_->TileRows() * store_->TileCols();
+  size_t elements = static_cast<size_t>(tile_size_) * tile_size_;
+  for (int t = 0; t < tiles; t++) {
+    int ti = t / store_->TileCols();
+    int tj = t % store_->TileCols();
+    if (t + 1 < tiles) {
+      store_->Prefetch((t + 1) / store_->TileCols(),
+                       (t + 1) % store_->TileCols());
+      other.store_->Prefetch((t + 1) / store_->TileCols(),
+                             (t + 1) % store_->TileCols());
+    }
+    TileStore::Handle out = store_->Acquire(ti, tj, true);
+    TileStore::Handle in = other.store_->Acquire(ti, tj, false);
+    for (size_t k = 0; k < elements; k++) {
+      out.Data()[k] += in.Data()[k];
+    }
+  }
+}
+
+void S21TiledMatrix::SubMatrix(const S21TiledMatrix &other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_ ||
+      tile_size_ != other.tile_size_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for addition.");
+  }
+  int tiles = store_->TileRows() * store_->TileCols();
+  size_t elements = static_cast<size_t>(tile_size_) * tile_size_;
+  for (int t = 0; t < tiles; t++) {
+    int ti = t / store_->TileCols();
+    int tj = t % store_->TileCols();
+    if (t + 1 < tiles) {
+      store_->Prefetch((t + 1) / store_->TileCols(),
+                       (t + 1) % store_->TileCols());
+      other.store_->Prefetch((t + 1) / store_->TileCols(),
+                             (t + 1) % store_->TileCols());
+    }
+    TileStore::Handle out = store_->Acquire(ti, tj, true);
+    TileStore::Handle in = other.store_->Acquire(ti, tj, false);
+    for (size_t k = 0; k < elements; k++) {
+      out.Data()[k] -= in.Data()[k];
+    }
+  }
+}
+
+void S21TiledMatrix::MulNumber(double num) {
+  if (num != num) {
+    throw std::invalid_argument("Incorrect argument for multiplication.");
+  }
+  int tiles = store_->TileRows() * store_->TileCols();
+  for (int t = 0; t < tiles; t++) {
+    int ti = t / store_->TileCols();
+    int tj = t % store_->TileCols();
+    if (t + 1 < tiles) {
+      store_->Prefetch((t + 1) / store_->TileCols(),
+                       (t + 1) % store_->TileCols());
+    }
+    TileStore::Handle out = store_->Acquire(ti, tj, true);
+    // Нули за краем матрицы не умножаются: 0 * inf дал бы NaN в плитке
+    int rows = std::min(tile_size_, rows_ - ti * tile_size_);
+    int cols = std::min(tile_size_, cols_ - tj * tile_size_);
+    for (int i = 0; i < rows; i++) {
+      double *row = out.Data() + i * tile_size_;
+      for (int j = 0; j < cols; j++) {
+        row[j] *= num;
+      }
+    }
+  }
+}
+
+void S21TiledMatrix::MulMatrix(const S21TiledMatrix &other) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Matrix dimensions are incompatible for multiplication.");
+  }
+  if (tile_size_ != other.tile_size_) {
+    throw std::invalid_argument("Tile sizes of the matrices differ.");
+  }
+  std::string path = store_->Path();
+  S21TiledMatrix result(path, Storage::kUnique, rows_, other.cols_,
+                        tile_size_, store_->Capacity());
+  int inner = store_->TileCols();
+  int t = tile_size_;
+  for (int ti = 0; ti < result.store_->TileRows(); ti++) {
+    for (int tj = 0; tj < result.store_->TileCols(); tj++) {
+      TileStore::Handle out = result.store_->Acquire(ti, tj, true);
+      double *c = out.Data();
+      int height = std::min(t, rows_ - ti * t);
+      int width = std::min(t, other.cols_ - tj * t);
+      for (int tk = 0; tk < inner; tk++) {
+        // Следующая пара плиток читается, пока считается текущая
+        if (tk + 1 < inner) {
+          store_->Prefetch(ti, tk + 1);
+          other.store_->Prefetch(tk + 1, tj);
+        } else if (tj + 1 < result.store_->TileCols()) {
+          other.store_->Prefetch(0, tj + 1);
+        }
+        TileStore::Handle left = store_->Acquire(ti, tk, false);
+        TileStore::Handle right = other.store_->Acquire(tk, tj, false);
+        const double *a = left.Data();
+        const double *b = right.Data();
+        // Краевые плитки считаются только по настоящим элементам, чтобы
+        // inf * 0 из нулей за краем не попадал в результат
+        int depth = std::min(t, cols_ - tk * t);
+        for (int i = 0; i < height; i++) {
+          double *c_row = c + i * t;
+          for (int k = 0; k < depth; k++) {
+            double aik = a[i * t + k];
+            const double *b_row = b + k * t;
+            for (int j = 0; j < width; j++) {
+              c_row[j] += aik * b_row[j];
+            }
+          }
+        }
+      }
+    }
+  }
+  store_.reset();
+  result.store_->Rename(path);
+  cols_ = other.cols_;
+  store_ = std::move(result.store_);
+}
+
+S21TiledMatrix S21TiledMatrix::Transpose(const std::string &path) const {
+  S21TiledMatrix result(path, cols_, rows_, tile_size_, store_->Capacity());
+  int t = tile_size_;
+  int tiles = store_->TileRows() * store_->TileCols();
+  for (int index = 0; index < tiles; index++) {
+    int ti = index / store_->TileCols();
+    int tj = index % store_->TileCols();
+    if (index + 1 < tiles) {
+      store_->Prefetch((index + 1) / store_->TileCols(),
+                       (index + 1) % store_->TileCols());
+    }
+    TileStore::Handle in = store_->Acquire(ti, tj, false);
+    TileStore::Handle out = result.store_->Acquire(tj, ti, true);
+    for (int i = 0; i < t; i++) {
+      for (int j = 0; j < t; j++) {
+        out.Data()[j * t + i] = in.Data()[i * t + j];
+      }
+    }
+  }
+  return result;
+}
+
+void S21TiledMatrix::Flush() { store_->Flush(); }
+
+double S21TiledMatrix::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is ​​not square.");
+  }
+  int n = rows_;
+  int t = tile_size_;
+  int tiles = store_->TileRows();
+  // Исходная матрица не меняется: обновленные столбцы плиток пишутся во
+  // временный файл, и с первого шага читаются уже оттуда
+  S21TiledMatrix work(store_->Path(), Storage::kUnlinked, n, n, t,
+                      store_->Capacity());
+  int prefetch_limit = std::max(1, store_->Capacity() / kPrefetchShare);
+
+  // Столбец плиток tj начиная со строки first_row в буфер (строка длины t)
+  auto load = [&](TileStore &source, int tj, int first_row,
+                  std::vector<double> &slab) {
+    slab.assign(static_cast<size_t>(n - first_row) * t, 0.0);
+    for (int ti = first_row / t; ti < tiles; ti++) {
+      TileStore::Handle tile = source.Acquire(ti, tj, false);
+      int row_end = std::min(n, (ti + 1) * t);
+      for (int i = ti * t; i < row_end; i++) {
+        std::copy(tile.Data() + (i - ti * t) * t,
+                  tile.Data() + (i - ti * t + 1) * t,
+                  slab.data() + static_cast<size_t>(i - first_row) * t);
+      }
+    }
+  };
+  auto save = [&](int tj, int first_row, const std::vector<double> &slab) {
+    for (int ti = first_row / t; ti < tiles; ti++) {
+      TileStore::Handle tile = work.store_->Acquire(ti, tj, true);
+      int row_end = std::min(n, (ti + 1) * t);
+      for (int i = ti * t; i < row_end; i++) {
+        const double *in =
+            slab.data() + static_cast<size_t>(i - first_row) * t;
+        std::copy(in, in + t, tile.Data() + (i - ti * t) * t);
+      }
+    }
+  };
+  auto prefetch = [&](TileStore &source, int tj, int first_row) {
+    int end = std::min(tiles, first_row / t + prefetch_limit);
+    for (int ti = first_row / t; ti < end; ti++) {
+      source.Prefetch(ti, tj);
+    }
+  };
+
+  double determinant = 1.0;
+  std::vector<double> panel;
+  std::vector<double> slab;
+  std::vector<int> pivots(t);
+  for (int kt = 0; kt < tiles; kt++) {
+    TileStore &source = kt == 0 ? *store_ : *work.store_;
+    int first = kt * t;
+    int width = std::min(t, n - first);
+    load(source, kt, first, panel);
+    // Разложение столбца плиток с выбором главного элемента по всем строкам
+    for (int c = 0; c < width; c++) {
+      int row = c;
+      int pivot = row;
+      for (int r = row + 1; r < n - first; r++) {
+        if (std::abs(panel[static_cast<size_t>(r) * t + c]) >
+            std::abs(panel[static_cast<size_t>(pivot) * t + c])) {
+          pivot = r;
+        }
+      }
+      pivots[c] = pivot;
+      double *pivot_row = panel.data() + static_cast<size_t>(row) * t;
+      if (pivot != row) {
+        std::swap_ranges(pivot_row, pivot_row + t,
+                         panel.data() + static_cast<size_t>(pivot) * t);
+        determinant = -determinant;
+      }
+      if (pivot_row[c] == 0.0) {
+        return 0.0;
+      }
+      determinant *= pivot_row[c];
+      for (int r = row + 1; r < n - first; r++) {
+        double *current = panel.data() + static_cast<size_t>(r) * t;
+        double factor = current[c] / pivot_row[c];
+        current[c] = factor;
+        for (int j = c + 1; j < width; j++) {
+          current[j] -= factor * pivot_row[j];
+        }
+      }
+    }
+    // Обновление оставшихся столбцов плиток
+    for (int tj = kt + 1; tj < tiles; tj++) {
+      load(source, tj, first, slab);
+      if (tj + 1 < tiles) {
+        prefetch(source, tj + 1, first);
+      }
+      for (int c = 0; c < width; c++) {
+        if (pivots[c] != c) {
+          std::swap_ranges(slab.data() + static_cast<size_t>(c) * t,
+                           slab.data() + static_cast<size_t>(c + 1) * t,
+                           slab.data() + static_cast<size_t>(pivots[c]) * t);
+        }
+      }
+      for (int c = 0; c < width; c++) {
+        const double *u_row = slab.data() + static_cast<size_t>(c) * t;
+        for (int r = c + 1; r < n - first; r++) {
+          double factor = panel[static_cast<size_t>(r) * t + c];
+          if (factor == 0.0) {
+            continue;
+          }
+          double *target = slab.data() + static_cast<size_t>(r) * t;
+          for (int j = 0; j < t; j++) {
+            target[j] -= factor * u_row[j];
+          }
+        }
+      }
+      save(tj, first, slab);
+    }
+  }
+  return determinant;
+}
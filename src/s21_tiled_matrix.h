@@ -0,0 +1,119 @@
+#ifndef SRC_S21_TILED_MATRIX_H_
+#define SRC_S21_TILED_MATRIX_H_
+
+#include <memory>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+/// @brief Матрица, которая хранится в файле квадратными плитками и целиком в
+/// память не загружается. В памяти держится ограниченный LRU-кэш плиток,
+/// фоновый поток заранее читает плитки, которые понадобятся следующими.
+/// Файл служит хранилищем на время жизни объекта и удаляется деструктором
+class S21TiledMatrix {
+ public:
+  /// @brief Сторона плитки по умолчанию (512 КБ на плитку)
+  static constexpr int kDefaultTileSize = 256;
+
+  /// @brief Количество плиток в кэше по умолчанию
+  static constexpr int kDefaultCacheTiles = 64;
+
+  /// @brief Создает нулевую матрицу в файле
+  /// @param path путь к файлу-хранилищу, существующий файл перезаписывается
+  /// @param rows кол-во строк
+  /// @param cols кол-во столбцов
+  /// @param tile_size сторона плитки
+  /// @param cache_tiles сколько плиток держать в памяти
+  S21TiledMatrix(const std::string &path, int rows, int cols,
+                 int tile_size = kDefaultTileSize,
+                 int cache_tiles = kDefaultCacheTiles);
+
+  /// @brief Создает матрицу в файле из обычной матрицы
+  /// @param matrix исходная матрица
+  /// @param path путь к файлу-хранилищу
+  /// @param tile_size сторона плитки
+  /// @param cache_tiles сколько плиток держать в памяти
+  S21TiledMatrix(const S21Matrix &matrix, const std::string &path,
+                 int tile_size = kDefaultTileSize,
+                 int cache_tiles = kDefaultCacheTiles);
+
+  S21TiledMatrix(const S21TiledMatrix &other) = delete;
+  S21TiledMatrix &operator=(const S21TiledMatrix &other) = delete;
+
+  /// @brief Конструктор переноса
+  /// @param other матрица которую переносим
+  S21TiledMatrix(S21TiledMatrix &&other);
+
+  /// @brief Оператор присваивания переносом
+  /// @param other матрица которую переносим
+  /// @return ссылка на текущую матрицу
+  S21TiledMatrix &operator=(S21TiledMatrix &&other);
+
+  ~S21TiledMatrix();  // Деструктор, удаляет файл-хранилище
+
+  int GetRows() const;
+  int GetCols() const;
+  int GetTileSize() const;
+
+  /// @brief Получаем значение элемента матрицы
+  /// @param row номер строки
+  /// @param col номер столбца
+  double GetElement(int row, int col) const;
+
+  /// @brief Устанавливает значение элемента
+  /// @param row номер строки
+  /// @param col номер столбца
+  /// @param value значение
+  void SetElement(int row, int col, double value);
+
+  /// @brief Загружает матрицу целиком в память
+  S21Matrix ToMatrix() const;
+
+  /// @brief Поэлементные операции, плитки обходятся по одной
+  /// @param other матрица того же размера и с той же стороной плитки
+  void SumMatrix(const S21TiledMatrix &other);
+  void SubMatrix(const S21TiledMatrix &other);
+
+  /// @brief Умножение на число
+  /// @param num число, на которое умножаем
+  void MulNumber(double num);
+
+  /// @brief Умножение матриц. Результат строится во временном файле рядом с
+  /// текущим и затем занимает его место. Строка плиток левой матрицы
+  /// переиспользуется для всей строки результата, поэтому кэш должен вмещать
+  /// хотя бы одну строку плиток
+  /// @param other матрица на которую умножаем
+  void MulMatrix(const S21TiledMatrix &other);
+
+  /// @brief Транспонирование плитка за плиткой
+  /// @param path путь к файлу-хранилищу результата
+  S21TiledMatrix Transpose(const std::string &path) const;
+
+  /// @brief Определитель через LU-разложение с выбором главного элемента.
+  /// В памяти одновременно находятся два столбца плиток (2 * rows *
+  /// tile_size чисел), промежуточные значения пишутся во временный файл
+  double Determinant() const;
+
+  /// @brief Записывает измененные плитки кэша в файл
+  void Flush();
+
+ private:
+  class TileStore;
+
+  // Как создается файл-хранилище
+  enum class Storage {
+    kPath,     // по заданному пути, существующий файл перезаписывается
+    kUnique,   // с уникальным именем path.XXXXXX, которое затем меняется
+    kUnlinked  // с уникальным именем, удаленным сразу после открытия
+  };
+
+  S21TiledMatrix(const std::string &path, Storage storage, int rows,
+                 int cols, int tile_size, int cache_tiles);
+
+  int rows_;
+  int cols_;
+  int tile_size_;
+  std::unique_ptr<TileStore> store_;
+};
+
+#endif  // SRC_S21_TILED_MATRIX_H_
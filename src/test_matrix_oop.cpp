@@ -1,8 +1,32 @@
 #include <gtest/gtest.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <csignal>
+#endif
 
+#include <cstdio>
 #include <iostream>
+#include <thread>
+#include <vector>
 
+#include "s21_bit_matrix.h"
+#include "s21_half_matrix.h"
+#include "s21_krylov.h"
+#include "s21_low_rank.h"
+#include "s21_matrix_async.h"
+#include "s21_matrix_layout.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_update.h"
+#include "s21_numa.h"
+#include "s21_parallel.h"
+#include "s21_quantized_matrix.h"
+#include "s21_semiring_matrix.h"
+#include "s21_shared_matrix.h"
+#include "s21_structured_matrix.h"
+#include "s21_tiled_matrix.h"
 
 TEST(Constructors, DefaultConstructor) {
   S21Matrix M;
@@ -587,6 +611,1805 @@ TEST(InverseMatrix, ZeroDeterminantAndNotSquare) {
   EXPECT_THROW(M.InverseMatrix(), std::logic_error);
 }
 
+TEST(QRDecomposition, ReconstructsTallMatrix) {
+  S21Matrix A(40, 35);
+  for (int i = 0; i < A.GetRows(); i++) {
+    for (int j = 0; j < A.GetCols(); j++) {
+      A(i, j) = std::sin(i * 1.3 + j * 0.7) + (i == j ? 2.0 : 0.0);
+    }
+  }
+  S21Matrix Q, R;
+  A.QRDecomposition(Q, R);
+  EXPECT_EQ(Q.GetRows(), 40);
+  EXPECT_EQ(Q.GetCols(), 35);
+  EXPECT_EQ(R.GetRows(), 35);
+  EXPECT_EQ(R.GetCols(), 35);
+  S21Matrix QR = Q * R;
+  S21Matrix QtQ = Q.Transpose() * Q;
+  for (int i = 0; i < A.GetRows(); i++) {
+    for (int j = 0; j < A.GetCols(); j++) {
+      EXPECT_NEAR(QR(i, j), A(i, j), 1e-12);
+    }
+  }
+  for (int i = 0; i < 35; i++) {
+    for (int j = 0; j < 35; j++) {
+      EXPECT_NEAR(QtQ(i, j), i == j ? 1.0 : 0.0, 1e-12);
+      if (i > j) {
+        EXPECT_EQ(R(i, j), 0.0);
+      }
+    }
+  }
+}
+
+TEST(LeastSquares, OverdeterminedAndUnderdetermined) {
+  // Точная прямая y = 2x + 1 на 10000 точках проходит через несколько блоков
+  S21Matrix A(10000, 2);
+  S21Matrix b(10000, 1);
+  for (int i = 0; i < A.GetRows(); i++) {
+    A(i, 0) = i * 0.001;
+    A(i, 1) = 1.0;
+    b(i, 0) = 2.0 * i * 0.001 + 1.0;
+  }
+  S21Matrix x = S21Matrix::LeastSquares(A, b);
+  EXPECT_NEAR(x(0, 0), 2.0, 1e-10);
+  EXPECT_NEAR(x(1, 0), 1.0, 1e-10);
+
+  // Невязка ортогональна столбцам матрицы
+  S21Matrix A2(5, 2);
+  S21Matrix b2(5, 1);
+  double values[5] = {1.0, 2.0, 1.5, 4.0, 3.0};
+  for (int i = 0; i < 5; i++) {
+    A2(i, 0) = i;
+    A2(i, 1) = 1.0;
+    b2(i, 0) = values[i];
+  }
+  S21Matrix x2 = S21Matrix::LeastSquares(A2, b2);
+  S21Matrix normal = A2.Transpose() * (A2 * x2 - b2);
+  EXPECT_NEAR(normal(0, 0), 0.0, 1e-12);
+  EXPECT_NEAR(normal(1, 0), 0.0, 1e-12);
+
+  // Решение с минимальной нормой для x + y = 2
+  S21Matrix A3(1, 2);
+  S21Matrix b3(1, 1);
+  A3(0, 0) = 1.0;
+  A3(0, 1) = 1.0;
+  b3(0, 0) = 2.0;
+  S21Matrix x3 = S21Matrix::LeastSquares(A3, b3);
+  EXPECT_NEAR(x3(0, 0), 1.0, 1e-14);
+  EXPECT_NEAR(x3(1, 0), 1.0, 1e-14);
+}
+
+TEST(LeastSquares, InvalidArguments) {
+  S21Matrix A(4, 2);
+  S21Matrix b(3, 1);
+  EXPECT_THROW(S21Matrix::LeastSquares(A, b), std::invalid_argument);
+  S21Matrix b2(4, 1);
+  EXPECT_THROW(S21Matrix::LeastSquares(A, b2), std::logic_error);
+}
+
+TEST(SymmetricEigen, SmallMatrixJacobi) {
+  S21Matrix M(3, 3);
+  M(0, 0) = 2.0;
+  M(0, 1) = -1.0;
+  M(1, 0) = -1.0;
+  M(1, 1) = 2.0;
+  M(1, 2) = -1.0;
+  M(2, 1) = -1.0;
+  M(2, 2) = 2.0;
+  S21Matrix vectors;
+  S21Matrix values = M.SymmetricEigen(&vectors);
+  EXPECT_EQ(values.GetRows(), 3);
+  EXPECT_NEAR(values(0, 0), 2.0 + std::sqrt(2.0), 1e-13);
+  EXPECT_NEAR(values(1, 0), 2.0, 1e-13);
+  EXPECT_NEAR(values(2, 0), 2.0 - std::sqrt(2.0), 1e-13);
+  S21Matrix residual = M * vectors;
+  for (int i = 0; i < 3; i++) {
+    for (int k = 0; k < 3; k++) {
+      EXPECT_NEAR(residual(i, k), values(k, 0) * vectors(i, k), 1e-13);
+    }
+  }
+}
+
+TEST(SymmetricEigen, LargeMatrixFullAndTopK) {
+  const int n = 40;
+  S21Matrix M(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) {
+      M(i, j) = std::cos(i * 0.37 + j * 1.11) + (i == j ? i * 0.5 : 0.0);
+      M(j, i) = M(i, j);
+    }
+  }
+  S21Matrix vectors;
+  S21Matrix values = M.SymmetricEigen(&vectors);
+  S21Matrix residual = M * vectors;
+  S21Matrix orthogonality = vectors.Transpose() * vectors;
+  double trace = 0.0;
+  for (int i = 0; i < n; i++) {
+    trace += M(i, i) - values(i, 0);
+    if (i > 0) {
+      EXPECT_GE(values(i - 1, 0), values(i, 0));
+    }
+    for (int k = 0; k < n; k++) {
+      EXPECT_NEAR(residual(i, k), values(k, 0) * vectors(i, k), 1e-11);
+      EXPECT_NEAR(orthogonality(i, k), i == k ? 1.0 : 0.0, 1e-12);
+    }
+  }
+  EXPECT_NEAR(trace, 0.0, 1e-11);
+
+  S21Matrix top_vectors;
+  S21Matrix top = M.SymmetricEigen(&top_vectors, 3);
+  S21Matrix top_only = M.SymmetricEigen(nullptr, 3);
+  EXPECT_EQ(top.GetRows(), 3);
+  EXPECT_EQ(top_vectors.GetCols(), 3);
+  S21Matrix top_residual = M * top_vectors;
+  for (int k = 0; k < 3; k++) {
+    EXPECT_NEAR(top(k, 0), values(k, 0), 1e-11);
+    EXPECT_NEAR(top_only(k, 0), values(k, 0), 1e-11);
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(top_residual(i, k), top(k, 0) * top_vectors(i, k), 1e-10);
+    }
+  }
+}
+
+TEST(SymmetricEigen, InvalidArguments) {
+  S21Matrix M(2, 3);
+  EXPECT_THROW(M.SymmetricEigen(), std::logic_error);
+  S21Matrix M2(2, 2);
+  M2(0, 1) = 1.0;
+  EXPECT_THROW(M2.SymmetricEigen(), std::invalid_argument);
+  S21Matrix M3(2, 2);
+  EXPECT_THROW(M3.SymmetricEigen(nullptr, 3), std::invalid_argument);
+}
+
+TEST(SymmetricEigen, NaNExhaustsQLIterations) {
+  // 20 x 20 идет через QL; NaN не сходится, и предел итераций прерывает
+  // вычисления исключением вместо молчаливого NaN в ответе
+  S21Matrix M(20, 20);
+  for (int i = 0; i < 20; i++) {
+    M(i, i) = i + 1.0;
+  }
+  M(3, 7) = std::nan("");
+  M(7, 3) = std::nan("");
+  EXPECT_THROW(M.SymmetricEigen(), std::runtime_error);
+  S21Matrix vectors;
+  EXPECT_THROW(M.SymmetricEigen(&vectors), std::runtime_error);
+}
+
+TEST(Power, BinaryExponentiation) {
+  S21Matrix M(2, 2);
+  M(0, 0) = 1.0;
+  M(0, 1) = 1.0;
+  M(1, 0) = 1.0;
+  // Числа Фибоначчи: M^k = [[F(k+1), F(k)], [F(k), F(k-1)]]
+  S21Matrix P = M.Power(30);
+  EXPECT_EQ(P(0, 0), 1346269.0);
+  EXPECT_EQ(P(0, 1), 832040.0);
+  EXPECT_EQ(P(1, 1), 514229.0);
+  S21Matrix repeated(M);
+  for (int i = 1; i < 7; i++) {
+    repeated *= M;
+  }
+  EXPECT_TRUE(M.Power(7) == repeated);
+  S21Matrix identity = M.Power(0);
+  EXPECT_EQ(identity(0, 0), 1.0);
+  EXPECT_EQ(identity(0, 1), 0.0);
+  EXPECT_EQ(identity(1, 1), 1.0);
+  S21Matrix inverse_cube = M.Power(-3);
+  S21Matrix product = inverse_cube * M.Power(3);
+  EXPECT_NEAR(product(0, 0), 1.0, 1e-12);
+  EXPECT_NEAR(product(0, 1), 0.0, 1e-12);
+  EXPECT_NEAR(product(1, 0), 0.0, 1e-12);
+  EXPECT_NEAR(product(1, 1), 1.0, 1e-12);
+  S21Matrix rectangular(2, 3);
+  EXPECT_THROW(rectangular.Power(2), std::logic_error);
+}
+
+TEST(Power, NegativeThroughLU) {
+  // Разложение по минорам на 40 x 40 не закончилось бы никогда
+  const int n = 40;
+  S21Matrix M(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      M(i, j) = std::sin(i * 1.3 + j * 0.7) + (i == j ? n : 0.0);
+    }
+  }
+  S21Matrix product = M.Power(-2) * M.Power(2);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      ASSERT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-12);
+    }
+  }
+  S21Matrix singular(n, n);
+  EXPECT_THROW(singular.Power(-1), std::logic_error);
+}
+
+TEST(Power, SymmetricLargeExponent) {
+  // Симметричная стохастическая матрица сходится к равномерной
+  S21Matrix M(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      M(i, j) = i == j ? 0.5 : 0.25;
+    }
+  }
+  S21Matrix expected(M);
+  for (int i = 1; i < 300; i++) {
+    expected *= M;
+  }
+  S21Matrix P = M.Power(300);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR(P(i, j), expected(i, j), 1e-12);
+      EXPECT_NEAR(P(i, j), 1.0 / 3.0, 1e-12);
+    }
+  }
+}
+
+TEST(UpdatableInverse, UpdatesMatchRecomputation) {
+  S21Matrix M(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      M(i, j) = std::sin(i * 2.1 + j * 0.9) + (i == j ? 3.0 : 0.0);
+    }
+  }
+  S21UpdatableInverse updatable(M, 100);
+  EXPECT_NEAR(updatable.Determinant(), M.Determinant(), 1e-10);
+
+  updatable.SetElement(1, 3, 2.5);
+  M(1, 3) = 2.5;
+  S21Matrix row(1, 5);
+  S21Matrix col(5, 1);
+  S21Matrix u(5, 1);
+  S21Matrix v(5, 1);
+  for (int i = 0; i < 5; i++) {
+    row(0, i) = i + 1.0;
+    col(i, 0) = 0.5 * i - 1.0;
+    u(i, 0) = 0.1 * i;
+    v(i, 0) = 0.2 - 0.05 * i;
+  }
+  updatable.ReplaceRow(2, row);
+  updatable.ReplaceColumn(4, col);
+  updatable.RankOneUpdate(u, v);
+  for (int j = 0; j < 5; j++) {
+    M(2, j) = row(0, j);
+  }
+  for (int i = 0; i < 5; i++) {
+    M(i, 4) = col(i, 0);
+  }
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      M(i, j) += u(i, 0) * v(j, 0);
+    }
+  }
+  EXPECT_EQ(updatable.UpdatesSinceRefactorization(), 4);
+  EXPECT_TRUE(updatable.Matrix() == M);
+  EXPECT_NEAR(updatable.Determinant(), M.Determinant(), 1e-10);
+  S21Matrix inverse = updatable.InverseMatrix();
+  S21Matrix expected = M.InverseMatrix();
+  S21Matrix x = updatable.Solve(col);
+  S21Matrix check = M * x;
+  for (int i = 0; i < 5; i++) {
+    EXPECT_NEAR(check(i, 0), col(i, 0), 1e-10);
+    for (int j = 0; j < 5; j++) {
+      EXPECT_NEAR(inverse(i, j), expected(i, j), 1e-10);
+    }
+  }
+}
+
+TEST(UpdatableInverse, SingularAndRefactorization) {
+  S21Matrix M(2, 2);
+  M(0, 0) = 1.0;
+  M(1, 1) = 1.0;
+  S21UpdatableInverse updatable(M, 2);
+  updatable.SetElement(0, 1, 1.0);
+  EXPECT_EQ(updatable.UpdatesSinceRefactorization(), 1);
+  // Матрица становится вырожденной
+  updatable.SetElement(1, 0, 1.0);
+  EXPECT_EQ(updatable.UpdatesSinceRefactorization(), 0);
+  EXPECT_EQ(updatable.Determinant(), 0.0);
+  EXPECT_THROW(updatable.InverseMatrix(), std::logic_error);
+  updatable.SetElement(1, 1, 3.0);
+  EXPECT_NEAR(updatable.Determinant(), 2.0, 1e-14);
+  EXPECT_NEAR(updatable.InverseMatrix()(0, 0), 1.5, 1e-14);
+  EXPECT_THROW(updatable.SetElement(2, 0, 1.0), std::out_of_range);
+  S21Matrix rectangular(2, 3);
+  EXPECT_THROW(S21UpdatableInverse bad(rectangular), std::logic_error);
+}
+
+TEST(Caching, RepeatedQueriesAndInvalidation) {
+  S21Matrix M(3, 3);
+  M(0, 0) = 2.0;
+  M(0, 1) = 5.0;
+  M(0, 2) = 7.0;
+  M(1, 0) = 6.0;
+  M(1, 1) = 3.0;
+  M(1, 2) = 4.0;
+  M(2, 0) = 5.0;
+  M(2, 1) = -2.0;
+  M(2, 2) = -3.0;
+  EXPECT_FALSE(M.IsCaching());
+  M.SetCaching(true);
+  EXPECT_TRUE(M.IsCaching());
+  EXPECT_EQ(M.Determinant(), -1.0);
+  S21Matrix inverse = M.InverseMatrix();
+  EXPECT_TRUE(M.InverseMatrix() == inverse);
+  EXPECT_TRUE(M.Transpose() == M.Transpose());
+
+  M.SetElement(0, 0, 1.0);
+  EXPECT_EQ(M.Determinant(), 0.0);
+  EXPECT_THROW(M.InverseMatrix(), std::logic_error);
+  M(0, 0) = 2.0;
+  EXPECT_EQ(M.Determinant(), -1.0);
+  EXPECT_EQ(M.Transpose()(0, 1), 6.0);
+  M.MulNumber(2.0);
+  EXPECT_EQ(M.Determinant(), -8.0);
+  EXPECT_EQ(M.Transpose()(0, 1), 12.0);
+  M.SumMatrix(M);
+  EXPECT_EQ(M.CalcComplements()(0, 0), -16.0);
+  M.SetRows(2);
+  EXPECT_THROW(M.Determinant(), std::logic_error);
+
+  // Копия наследует режим, перенос сохраняет режим приемника
+  S21Matrix copy(M);
+  EXPECT_TRUE(copy.IsCaching());
+  copy.MulMatrix(M.Transpose());
+  EXPECT_TRUE(copy.IsCaching());
+  EXPECT_EQ(copy.GetRows(), 2);
+  EXPECT_EQ(copy.GetCols(), 2);
+  copy.SetCaching(false);
+  EXPECT_FALSE(copy.IsCaching());
+
+  // Оба присваивания сохраняют режим приемника
+  S21Matrix plain(1, 1);
+  plain = M;
+  EXPECT_FALSE(plain.IsCaching());
+  S21Matrix cached(1, 1);
+  cached.SetCaching(true);
+  cached = copy;
+  EXPECT_TRUE(cached.IsCaching());
+  cached = S21Matrix(2, 2);
+  EXPECT_TRUE(cached.IsCaching());
+  EXPECT_EQ(cached.Determinant(), 0.0);
+  plain = std::move(M);
+  EXPECT_FALSE(plain.IsCaching());
+  EXPECT_EQ(plain.GetRows(), 2);
+}
+
+TEST(Caching, RepeatedQueriesAreServedFromCache) {
+  S21Matrix M(3, 3);
+  M(0, 0) = 2.0;
+  M(1, 1) = 4.0;
+  M(2, 2) = 5.0;
+  M(0, 2) = 1.0;
+  // Разделение у M выключено: ответы из кэша все равно не копируются
+  M.SetCaching(true);
+  const S21Matrix &view = M;
+  auto address = [](const S21Matrix &matrix) { return &matrix(0, 0); };
+  EXPECT_EQ(M.Determinant(), 40.0);
+  S21Matrix t1 = M.Transpose();
+  S21Matrix i1 = M.InverseMatrix();
+  // Повторный запрос возвращает тот же буфер, а не новый результат
+  EXPECT_FALSE(M.IsSharing());
+  EXPECT_TRUE(t1.IsShared());
+  EXPECT_EQ(address(M.Transpose()), address(t1));
+  EXPECT_EQ(address(M.InverseMatrix()), address(i1));
+  // Запись в обход изменяющих методов кэш не сбрасывает: ответы устаревшие,
+  // значит они не пересчитываются
+  const_cast<double &>(view(0, 0)) = 3.0;
+  EXPECT_EQ(M.Determinant(), 40.0);
+  EXPECT_EQ(M.Transpose()(0, 0), 2.0);
+  EXPECT_EQ(M.InverseMatrix()(0, 0), 0.5);
+  // Изменяющий метод сбрасывает кэш
+  M.SetElement(0, 0, 3.0);
+  EXPECT_EQ(M.Determinant(), 60.0);
+  S21Matrix t2 = M.Transpose();
+  EXPECT_NE(address(t2), address(t1));
+  EXPECT_EQ(t2(0, 0), 3.0);
+  EXPECT_EQ(t1(0, 0), 2.0);
+  EXPECT_NEAR(M.InverseMatrix()(0, 0), 1.0 / 3.0, 1e-15);
+}
+
+TEST(TiledMatrix, ConversionAndElementwise) {
+  S21Matrix A(10, 7);
+  S21Matrix B(10, 7);
+  for (int i = 0; i < 10; i++) {
+    for (int j = 0; j < 7; j++) {
+      A(i, j) = i * 7 + j;
+      B(i, j) = std::cos(i + 2.0 * j);
+    }
+  }
+  S21TiledMatrix tiled_a(A, "tiled_test_a.bin", 4, 4);
+  S21TiledMatrix tiled_b(B, "tiled_test_b.bin", 4, 4);
+  EXPECT_TRUE(tiled_a.ToMatrix() == A);
+  EXPECT_EQ(tiled_a.GetElement(9, 6), 69.0);
+  EXPECT_THROW(tiled_a.GetElement(10, 0), std::out_of_range);
+  tiled_a.SumMatrix(tiled_b);
+  tiled_a.MulNumber(2.0);
+  tiled_a.SubMatrix(tiled_b);
+  tiled_a.SetElement(0, 0, -1.0);
+  S21Matrix expected = (A + B) * 2.0 - B;
+  expected(0, 0) = -1.0;
+  EXPECT_TRUE(tiled_a.ToMatrix() == expected);
+  S21TiledMatrix transposed = tiled_a.Transpose("tiled_test_t.bin");
+  EXPECT_TRUE(transposed.ToMatrix() == expected.Transpose());
+  S21TiledMatrix wrong("tiled_test_w.bin", 7, 10, 4, 4);
+  EXPECT_THROW(tiled_a.SumMatrix(wrong), std::invalid_argument);
+}
+
+TEST(TiledMatrix, MultiplicationAndDeterminant) {
+  const int n = 13;
+  S21Matrix A(n, n);
+  S21Matrix B(n, 5);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      A(i, j) = std::sin(i * 1.7 + j * 0.3) + (i == j ? 1.5 : 0.0);
+    }
+    for (int j = 0; j < 5; j++) {
+      B(i, j) = i - j;
+    }
+  }
+  S21TiledMatrix tiled_a(A, "tiled_test_a.bin", 4, 6);
+  S21TiledMatrix tiled_b(B, "tiled_test_b.bin", 4, 6);
+  S21UpdatableInverse reference(A);
+  EXPECT_NEAR(tiled_a.Determinant(), reference.Determinant(), 1e-9);
+  EXPECT_TRUE(tiled_a.ToMatrix() == A);
+  tiled_a.MulMatrix(tiled_b);
+  EXPECT_EQ(tiled_a.GetCols(), 5);
+  S21Matrix product = tiled_a.ToMatrix();
+  S21Matrix expected = A * B;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_NEAR(product(i, j), expected(i, j), 1e-12);
+    }
+  }
+  EXPECT_THROW(tiled_a.Determinant(), std::logic_error);
+  S21TiledMatrix singular("tiled_test_s.bin", 5, 5, 2, 4);
+  EXPECT_EQ(singular.Determinant(), 0.0);
+}
+
+TEST(TiledMatrix, ScratchFilesKeepNeighbours) {
+  // Файлы с именами прежних временных файлов не должны затираться
+  const char *names[] = {"tiled_test_n.bin.mul", "tiled_test_n.bin.lu"};
+  for (const char *name : names) {
+    std::FILE *file = std::fopen(name, "w");
+    ASSERT_NE(file, nullptr);
+    std::fputs("keep", file);
+    std::fclose(file);
+  }
+  S21Matrix A(5, 5);
+  for (int i = 0; i < 5; i++) {
+    A(i, i) = i + 1.0;
+  }
+  S21TiledMatrix tiled(A, "tiled_test_n.bin", 2, 4);
+  EXPECT_NEAR(tiled.Determinant(), 120.0, 1e-12);
+  S21TiledMatrix twice(A * 2.0, "tiled_test_i.bin", 2, 4);
+  tiled.MulMatrix(twice);
+  EXPECT_TRUE(tiled.ToMatrix() == A * A * 2.0);
+  for (const char *name : names) {
+    char buffer[8] = {};
+    std::FILE *file = std::fopen(name, "r");
+    ASSERT_NE(file, nullptr);
+    ASSERT_NE(std::fgets(buffer, sizeof(buffer), file), nullptr);
+    std::fclose(file);
+    EXPECT_STREQ(buffer, "keep");
+    std::remove(name);
+  }
+}
+
+TEST(TiledMatrix, InfiniteScaleKeepsPadding) {
+  // 5 x 5 при плитке 4: у крайних плиток есть нулевые края
+  S21Matrix ones(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      ones(i, j) = 1.0;
+    }
+  }
+  S21TiledMatrix a(ones, "tiled_test_a.bin", 4, 4);
+  S21TiledMatrix b(ones, "tiled_test_b.bin", 4, 4);
+  a.MulNumber(std::numeric_limits<double>::infinity());
+  a.MulMatrix(b);
+  S21Matrix product = a.ToMatrix();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_TRUE(std::isinf(product(i, j)) && product(i, j) > 0);
+    }
+  }
+}
+
+TEST(TiledMatrix, InfiniteEntryKeepsPaddingAcrossProducts) {
+  S21Matrix ones(5, 5);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      ones(i, j) = 1.0;
+    }
+  }
+  S21Matrix source = ones;
+  source(4, 4) = std::numeric_limits<double>::infinity();
+  S21TiledMatrix a(source, "tiled_test_a.bin", 4, 4);
+  S21TiledMatrix b(ones, "tiled_test_b.bin", 4, 4);
+  S21TiledMatrix c(ones, "tiled_test_c.bin", 4, 4);
+  a.MulMatrix(b);
+  a.MulMatrix(c);
+  S21Matrix expected = source * ones * ones;
+  S21Matrix product = a.ToMatrix();
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      EXPECT_EQ(product(i, j), expected(i, j));
+    }
+  }
+}
+
+TEST(TiledMatrix, FailedWriteBackReachesFlush) {
+  S21Matrix A(8, 8);
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) {
+      A(i, j) = i * 8 + j;
+    }
+  }
+  S21TiledMatrix tiled(A, "tiled_test_f.bin", 4, 4);
+  tiled.SetElement(5, 6, -1.0);
+  // Нулевой предел размера файла: любая запись плитки завершится ошибкой
+  rlimit saved;
+  ASSERT_EQ(getrlimit(RLIMIT_FSIZE, &saved), 0);
+  rlimit limit = saved;
+  limit.rlim_cur = 0;
+  void (*handler)(int) = signal(SIGXFSZ, SIG_IGN);
+  ASSERT_EQ(setrlimit(RLIMIT_FSIZE, &limit), 0);
+  bool thrown = false;
+  try {
+    tiled.Flush();
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  setrlimit(RLIMIT_FSIZE, &saved);
+  signal(SIGXFSZ, handler);
+  EXPECT_TRUE(thrown);
+  // Плитки остались в кэше измененными и записываются повторным Flush
+  EXPECT_NO_THROW(tiled.Flush());
+  A(5, 6) = -1.0;
+  EXPECT_TRUE(tiled.ToMatrix().EqMatrix(A));
+}
+
+TEST(MatrixExecutor, ExpressionGraph) {
+  S21Matrix A(3, 3);
+  A(0, 0) = 2.0;
+  A(0, 1) = 5.0;
+  A(0, 2) = 7.0;
+  A(1, 0) = 6.0;
+  A(1, 1) = 3.0;
+  A(1, 2) = 4.0;
+  A(2, 0) = 5.0;
+  A(2, 1) = -2.0;
+  A(2, 2) = -3.0;
+  S21Matrix B(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      B(i, j) = i + j;
+    }
+  }
+  S21Matrix expected = (A.InverseMatrix() * B).Transpose() + B * 2.0;
+
+  S21MatrixExecutor executor(4);
+  EXPECT_EQ(executor.GetThreads(), 4);
+  S21MatrixFuture a = executor.Constant(A);
+  S21MatrixFuture b = executor.Constant(B);
+  // Две независимые ветви сходятся в сложении
+  S21MatrixFuture left =
+      executor.Transpose(executor.Mul(executor.InverseMatrix(a), b));
+  S21MatrixFuture right = executor.MulNumber(b, 2.0);
+  S21MatrixFuture sum = executor.Sum(left, right);
+  EXPECT_TRUE(sum.Get() == expected);
+  EXPECT_TRUE(left.Ready());
+
+  std::vector<S21MatrixFuture> parts;
+  for (int k = 0; k < 16; k++) {
+    parts.push_back(executor.Submit(
+        [k](const std::vector<const S21Matrix *> &args) {
+          return *args[0] * static_cast<double>(k);
+        },
+        {b}));
+  }
+  S21MatrixFuture total = parts[0];
+  for (int k = 1; k < 16; k++) {
+    total = executor.Sum(total, parts[k]);
+  }
+  executor.WaitAll();
+  EXPECT_TRUE(total.Ready());
+  EXPECT_TRUE(total.Get() == B * 120.0);
+}
+
+TEST(MatrixExecutor, ErrorsPropagate) {
+  S21MatrixExecutor executor(2);
+  S21Matrix singular(2, 2);
+  S21MatrixFuture inverse = executor.InverseMatrix(executor.Constant(singular));
+  S21MatrixFuture product = executor.Mul(inverse, executor.Constant(singular));
+  EXPECT_THROW(product.Get(), std::logic_error);
+  EXPECT_THROW(inverse.Get(), std::logic_error);
+  S21MatrixFuture empty;
+  EXPECT_FALSE(empty.Valid());
+  EXPECT_THROW(empty.Get(), std::logic_error);
+  EXPECT_THROW(executor.Transpose(empty), std::invalid_argument);
+}
+
+TEST(Reductions, NormsAndExtremes) {
+  S21Matrix M(2, 3);
+  M(0, 0) = 1.0;
+  M(0, 1) = -2.0;
+  M(0, 2) = 3.0;
+  M(1, 0) = -4.0;
+  M(1, 1) = 5.0;
+  M(1, 2) = -6.0;
+  EXPECT_EQ(M.Sum(), -3.0);
+  EXPECT_EQ(M.Min(), -6.0);
+  EXPECT_EQ(M.Max(), 5.0);
+  EXPECT_EQ(M.Norm1(), 9.0);
+  EXPECT_EQ(M.NormInf(), 15.0);
+  EXPECT_DOUBLE_EQ(M.NormFrobenius(), std::sqrt(91.0));
+  S21Matrix rows = M.RowSums();
+  S21Matrix cols = M.ColSums();
+  EXPECT_EQ(rows(0, 0), 2.0);
+  EXPECT_EQ(rows(1, 0), -5.0);
+  EXPECT_EQ(cols(0, 0), -3.0);
+  EXPECT_EQ(cols(0, 2), -3.0);
+  S21Matrix row_max =
+      M.ReduceRows([](double acc, double x) { return std::max(acc, x); },
+                   -1e300);
+  S21Matrix col_products =
+      M.ReduceCols([](double acc, double x) { return acc * x; }, 1.0);
+  EXPECT_EQ(row_max(0, 0), 3.0);
+  EXPECT_EQ(row_max(1, 0), 5.0);
+  EXPECT_EQ(col_products(0, 1), -10.0);
+  EXPECT_THROW(M.Trace(), std::logic_error);
+  S21Matrix square(2, 2);
+  square(0, 0) = 1.5;
+  square(1, 1) = 2.5;
+  EXPECT_EQ(square.Trace(), 4.0);
+}
+
+TEST(Reductions, LargeParallelSum) {
+  S21SetThreadCount(4);
+  S21Matrix M(600, 300);
+  for (int i = 0; i < 600; i++) {
+    for (int j = 0; j < 300; j++) {
+      M(i, j) = 0.1;
+    }
+  }
+  EXPECT_NEAR(M.Sum(), 18000.0, 1e-9);
+  EXPECT_NEAR(M.ColSums()(0, 299), 60.0, 1e-12);
+  EXPECT_NEAR(M.Norm1(), 60.0, 1e-12);
+  EXPECT_EQ(S21GetThreadCount(), 4);
+  // Суммы столбцов побитово совпадают при любом числе потоков
+  for (int i = 0; i < 600; i++) {
+    for (int j = 0; j < 300; j++) {
+      M(i, j) = std::sin(i * 0.37 + j * 1.3) * (1 + i % 7);
+    }
+  }
+  S21Matrix reference = M.ColSums();
+  for (int threads : {1, 3, 5}) {
+    S21SetThreadCount(threads);
+    S21Matrix sums = M.ColSums();
+    for (int j = 0; j < 300; j++) {
+      ASSERT_EQ(sums(0, j), reference(0, j));
+    }
+  }
+  S21SetThreadCount(0);
+  EXPECT_GE(S21GetThreadCount(), 1);
+}
+
+TEST(Reductions, ApplyMapZip) {
+  S21Matrix M(2, 2);
+  M(0, 0) = 1.0;
+  M(0, 1) = 4.0;
+  M(1, 0) = 9.0;
+  M(1, 1) = 16.0;
+  S21Matrix roots = M.Map([](double x) { return std::sqrt(x); });
+  EXPECT_EQ(roots(1, 1), 4.0);
+  S21Matrix products = M.Zip(roots, [](double a, double b) { return a * b; });
+  EXPECT_EQ(products(1, 0), 27.0);
+  M.SetCaching(true);
+  EXPECT_EQ(M.Determinant(), -20.0);
+  M.Apply([](double x) { return x + 1.0; });
+  EXPECT_EQ(M(0, 0), 2.0);
+  EXPECT_EQ(M.Determinant(), -16.0);
+  S21Matrix wrong(3, 2);
+  EXPECT_THROW(M.Zip(wrong, [](double a, double b) { return a + b; }),
+               std::invalid_argument);
+}
+
+TEST(Solve, MixedPrecisionRefinement) {
+  const int n = 60;
+  S21Matrix A(n, n);
+  S21Matrix x(n, 2);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      A(i, j) = (i == j) ? n + 1.0 : 1.0 / (1.0 + i + 2.0 * j);
+    }
+    x(i, 0) = 1.0 + i * 0.125;
+    x(i, 1) = std::sin(i + 1.0);
+  }
+  S21Matrix b = A * x;
+  int refinements = -2;
+  S21Matrix solution = A.Solve(b, &refinements);
+  EXPECT_GE(refinements, 1);
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(solution(i, 0), x(i, 0), 1e-13);
+    EXPECT_NEAR(solution(i, 1), x(i, 1), 1e-13);
+  }
+  S21Matrix wrong(n + 1, 1);
+  EXPECT_THROW(A.Solve(wrong), std::invalid_argument);
+  S21Matrix rectangle(2, 3);
+  EXPECT_THROW(rectangle.Solve(b), std::logic_error);
+}
+
+TEST(Solve, FallsBackToDouble) {
+  // Матрица Гильберта: для float слишком плохо обусловлена
+  const int n = 10;
+  S21Matrix H(n, n);
+  S21Matrix b(n, 1);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      H(i, j) = 1.0 / (i + j + 1.0);
+      b(i, 0) += H(i, j);
+    }
+  }
+  int refinements = 0;
+  S21Matrix solution = H.Solve(b, &refinements);
+  EXPECT_EQ(refinements, -1);
+  S21Matrix residual = H * solution - b;
+  EXPECT_LT(residual.NormInf(), 1e-12);
+  S21Matrix singular(2, 2);
+  singular(0, 0) = 1.0;
+  singular(0, 1) = 2.0;
+  singular(1, 0) = 2.0;
+  singular(1, 1) = 4.0;
+  S21Matrix rhs(2, 1);
+  EXPECT_THROW(singular.Solve(rhs), std::logic_error);
+}
+
+TEST(Structured, DiagonalAndTriangular) {
+  S21Matrix A(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      A(i, j) = i * 3 + j + 1.0;
+    }
+  }
+  S21DiagonalMatrix D(3);
+  D.SetElement(0, 0, 2.0);
+  D.SetElement(1, 1, -1.0);
+  D.SetElement(2, 2, 0.5);
+  EXPECT_TRUE((D * A) == D.ToMatrix() * A);
+  EXPECT_TRUE((A * D) == A * D.ToMatrix());
+  EXPECT_TRUE((D + A) == D.ToMatrix() + A);
+  EXPECT_EQ(D.Determinant(), -1.0);
+  EXPECT_EQ(D.Solve(A)(2, 1), 16.0);
+  EXPECT_THROW(D.SetElement(0, 1, 1.0), std::invalid_argument);
+  EXPECT_THROW(S21DiagonalMatrix{A}, std::invalid_argument);
+
+  S21Matrix upper(3, 3);
+  upper(0, 0) = 2.0;
+  upper(0, 1) = 1.0;
+  upper(0, 2) = -1.0;
+  upper(1, 1) = 3.0;
+  upper(1, 2) = 4.0;
+  upper(2, 2) = -2.0;
+  S21TriangularMatrix U(upper, true);
+  EXPECT_TRUE(U.ToMatrix() == upper);
+  EXPECT_EQ(U.GetElement(2, 0), 0.0);
+  EXPECT_EQ(U.Determinant(), -12.0);
+  EXPECT_TRUE((U * A) == upper * A);
+  EXPECT_TRUE((A * U) == A * upper);
+  S21TriangularMatrix U2(U);
+  U2.MulMatrix(U);
+  EXPECT_TRUE(U2.ToMatrix() == upper * upper);
+  S21Matrix x = U.Solve(A);
+  S21Matrix check = upper * x - A;
+  EXPECT_LT(check.NormInf(), 1e-12);
+  S21TriangularMatrix L(upper.Transpose(), false);
+  S21Matrix y = L.Solve(A);
+  check = upper.Transpose() * y - A;
+  EXPECT_LT(check.NormInf(), 1e-12);
+  EXPECT_THROW(S21TriangularMatrix(upper, false), std::invalid_argument);
+  EXPECT_THROW(U.SumMatrix(L), std::invalid_argument);
+}
+
+TEST(Structured, SymmetricProducts) {
+  S21Matrix A(4, 3);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      A(i, j) = (i + 1) * (j + 2) % 5 - 1.5;
+    }
+  }
+  S21SymmetricMatrix G = S21SymmetricMatrix::Gram(A);
+  S21Matrix gram = A.Transpose() * A;
+  EXPECT_TRUE(G.ToMatrix() == gram);
+  EXPECT_EQ(G.GetElement(0, 2), G.GetElement(2, 0));
+  EXPECT_TRUE((G * A.Transpose()) == gram * A.Transpose());
+  EXPECT_TRUE((A * G) == A * gram);
+  G.SetElement(0, 1, 7.0);
+  EXPECT_EQ(G.GetElement(1, 0), 7.0);
+  S21SymmetricMatrix copy(G.ToMatrix());
+  copy.SubMatrix(G);
+  EXPECT_EQ(copy.ToMatrix().NormInf(), 0.0);
+  EXPECT_THROW(S21SymmetricMatrix{A}, std::logic_error);
+  S21Matrix nonsymmetric(2, 2);
+  nonsymmetric(0, 1) = 1.0;
+  EXPECT_THROW(S21SymmetricMatrix{nonsymmetric}, std::invalid_argument);
+}
+
+TEST(Structured, BandSolve) {
+  // Трехдиагональная матрица с нулем на диагонали: без перестановок строк
+  // решить нельзя
+  const int n = 50;
+  S21BandMatrix T(n, 1, 1);
+  for (int i = 0; i < n; i++) {
+    T.SetElement(i, i, i == 0 ? 0.0 : 4.0 + i % 3);
+    if (i > 0) {
+      T.SetElement(i, i - 1, 1.0 + i % 2);
+    }
+    if (i + 1 < n) {
+      T.SetElement(i, i + 1, -1.0);
+    }
+  }
+  S21Matrix dense = T.ToMatrix();
+  EXPECT_EQ(T.GetElement(0, 5), 0.0);
+  EXPECT_THROW(T.SetElement(0, 5, 1.0), std::invalid_argument);
+  S21Matrix b(n, 2);
+  for (int i = 0; i < n; i++) {
+    b(i, 0) = 1.0;
+    b(i, 1) = i * 0.5;
+  }
+  S21Matrix x = T.Solve(b);
+  S21Matrix residual = dense * x - b;
+  EXPECT_LT(residual.NormInf(), 1e-12);
+  EXPECT_TRUE((T * b) == dense * b);
+  EXPECT_TRUE((b.Transpose() * T) == b.Transpose() * dense);
+  S21Matrix block(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      block(i, j) = T.GetElement(i, j);
+    }
+  }
+  S21BandMatrix four(block, 1, 2);
+  EXPECT_NEAR(four.Determinant(), block.Determinant(), 1e-12);
+  EXPECT_THROW(S21BandMatrix(dense, 0, 1), std::invalid_argument);
+  S21BandMatrix singular(3, 0, 1);
+  EXPECT_THROW(singular.Solve(b), std::invalid_argument);
+  S21Matrix rhs(3, 1);
+  EXPECT_THROW(singular.Solve(rhs), std::logic_error);
+}
+
+TEST(Layout, MultiplyAllCombinations) {
+  S21Matrix A(37, 45);
+  S21Matrix B(45, 70);
+  for (int i = 0; i < 45; i++) {
+    for (int j = 0; j < 70; j++) {
+      if (i < 37) {
+        A(i, j % 45) = std::sin(i * 0.3 + j * 0.7);
+      }
+      B(i, j) = std::cos(i * 0.11 - j * 0.5);
+    }
+  }
+  S21Matrix expected = A * B;
+  const S21Layout layouts[] = {S21Layout::kRowMajor, S21Layout::kColMajor,
+                               S21Layout::kMortonTiles};
+  for (S21Layout left : layouts) {
+    for (S21Layout right : layouts) {
+      S21LayoutMatrix product =
+          S21LayoutMatrix(A, left) * S21LayoutMatrix(B, right);
+      EXPECT_EQ(product.GetLayout(), left);
+      S21Matrix result = product.ToMatrix();
+      S21Matrix error = result - expected;
+      EXPECT_LT(error.NormInf(), 1e-12);
+    }
+  }
+  S21LayoutMatrix wrong(3, 3);
+  EXPECT_THROW(S21LayoutMatrix(A, S21Layout::kRowMajor) * wrong,
+               std::invalid_argument);
+}
+
+TEST(Layout, RelayoutAndExternalData) {
+  // Буфер, записанный по столбцам (как в Fortran), принимается без
+  // перестановки
+  const double fortran[] = {1.0, 4.0, 2.0, 5.0, 3.0, 6.0};
+  S21LayoutMatrix M(fortran, 2, 3, S21Layout::kColMajor);
+  EXPECT_EQ(M(0, 2), 3.0);
+  EXPECT_EQ(M(1, 0), 4.0);
+  EXPECT_EQ(M.ColSums()(0, 1), 7.0);
+  EXPECT_EQ(M.RowSums()(1, 0), 15.0);
+  S21LayoutMatrix T = M.Transpose();
+  EXPECT_EQ(T.GetLayout(), S21Layout::kRowMajor);
+  EXPECT_EQ(T(2, 1), 6.0);
+
+  S21Matrix big(70, 40);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 40; j++) {
+      big(i, j) = i * 100 + j;
+    }
+  }
+  S21LayoutMatrix L(big, S21Layout::kRowMajor);
+  L.Relayout(S21Layout::kMortonTiles);
+  EXPECT_EQ(L.GetStorageSize(), 3u * 2u * 32u * 32u);
+  EXPECT_EQ(L(69, 39), 6939.0);
+  EXPECT_TRUE(L.ToMatrix() == big);
+  EXPECT_TRUE(L.Transpose().ToMatrix() == big.Transpose());
+  L.Relayout(S21Layout::kColMajor);
+  EXPECT_EQ(L.Data()[1], 100.0);
+  S21LayoutMatrix R(big, S21Layout::kMortonTiles);
+  L.SubMatrix(R);
+  EXPECT_EQ(L.ToMatrix().NormInf(), 0.0);
+  EXPECT_EQ(R.ColSums()(0, 3), big.ColSums()(0, 3));
+  EXPECT_THROW(L(70, 0), std::out_of_range);
+}
+
+TEST(Sharing, CopyOnWrite) {
+  S21Matrix A(3, 3);
+  A.SetElement(0, 0, 1.0);
+  A.SetElement(1, 1, 2.0);
+  A.SetElement(2, 2, 3.0);
+  A.SetSharing(true);
+  // Чтение через неконстантный operator() запретило бы делить буфер A
+  const S21Matrix &a = A;
+  EXPECT_TRUE(A.IsSharing());
+  EXPECT_FALSE(A.IsShared());
+  S21Matrix B(A);
+  const S21Matrix &view = B;
+  EXPECT_TRUE(A.IsShared());
+  EXPECT_TRUE(B.IsSharing());
+  EXPECT_EQ(&view(1, 1), &a(1, 1));
+  B(1, 1) = 20.0;
+  EXPECT_FALSE(A.IsShared());
+  EXPECT_EQ(a(1, 1), 2.0);
+  EXPECT_EQ(B(1, 1), 20.0);
+
+  S21Matrix C(2, 2);
+  C = A;
+  EXPECT_TRUE(C.IsShared());
+  C.SetRows(4);
+  EXPECT_TRUE(C.IsSharing());
+  EXPECT_EQ(C.GetRows(), 4);
+  EXPECT_EQ(C(2, 2), 3.0);
+  EXPECT_EQ(C(3, 2), 0.0);
+  EXPECT_EQ(A.GetRows(), 3);
+  // Тот же размер ничего не меняет и не отделяет буфер
+  S21Matrix F = A;
+  F.SetCols(3);
+  EXPECT_TRUE(F.IsShared());
+  F.SetCols(2);
+  EXPECT_FALSE(F.IsShared());
+  EXPECT_EQ(F(1, 1), 2.0);
+  EXPECT_EQ(A.GetCols(), 3);
+  EXPECT_EQ(a(2, 2), 3.0);
+  S21Matrix P = A.Power(3);
+  EXPECT_EQ(P(2, 2), 27.0);
+  EXPECT_EQ(a(2, 2), 3.0);
+  S21Matrix D = A;
+  D.MulMatrix(A);
+  EXPECT_EQ(D(1, 1), 4.0);
+  EXPECT_EQ(a(1, 1), 2.0);
+  S21Matrix E = A;
+  E.SetSharing(false);
+  EXPECT_FALSE(E.IsSharing());
+  EXPECT_FALSE(A.IsShared());
+  E.MulNumber(2.0);
+  EXPECT_EQ(a(0, 0), 1.0);
+  EXPECT_EQ(E(0, 0), 2.0);
+
+  A.SetCaching(true);
+  S21Matrix T1 = A.Transpose();
+  S21Matrix T2 = A.Transpose();
+  EXPECT_TRUE(T1.IsShared());
+  EXPECT_EQ(&static_cast<const S21Matrix &>(T1)(0, 0),
+            &static_cast<const S21Matrix &>(T2)(0, 0));
+}
+
+TEST(Sharing, MutableReferenceStopsSharing) {
+  S21Matrix M(2, 2);
+  M.SetSharing(true);
+  double &r = M(0, 0);
+  S21Matrix copy(M);
+  EXPECT_FALSE(M.IsShared());
+  EXPECT_TRUE(copy.IsSharing());
+  r = 5.0;
+  EXPECT_EQ(static_cast<const S21Matrix &>(copy)(0, 0), 0.0);
+  S21Matrix assigned(1, 1);
+  assigned = M;
+  EXPECT_FALSE(M.IsShared());
+  // Другой изменяющий метод делает ссылку недействительной, и буфер снова
+  // делится
+  M.SetElement(1, 1, 2.0);
+  S21Matrix shared(M);
+  EXPECT_TRUE(M.IsShared());
+  EXPECT_EQ(static_cast<const S21Matrix &>(shared)(0, 0), 5.0);
+}
+
+TEST(Sharing, ThreadFanOut) {
+  S21Matrix source(200, 200);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 200; j++) {
+      source.SetElement(i, j, i - j);
+    }
+  }
+  source.SetSharing(true);
+  std::vector<double> sums(8);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < 8; t++) {
+    workers.emplace_back(
+        [t, &sums](S21Matrix copy) {
+          const S21Matrix &view = copy;
+          double sum = 0.0;
+          for (int i = 0; i < 200; i++) {
+            sum += view(i, t);
+          }
+          // Половина потоков изменяет свою копию
+          if (t % 2 == 0) {
+            copy.MulNumber(-1.0);
+            sum += copy(0, t);
+          }
+          sums[t] = sum;
+        },
+        source);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  for (int t = 0; t < 8; t++) {
+    double expected = 200.0 * (199.0 / 2.0 - t);
+    EXPECT_DOUBLE_EQ(sums[t], t % 2 == 0 ? expected + t : expected);
+  }
+  EXPECT_FALSE(source.IsShared());
+  EXPECT_EQ(source(0, 7), -7.0);
+}
+
+TEST(Numa, AllocationPolicies) {
+  EXPECT_GE(S21NumaNodeCount(), 1);
+  const S21NumaPolicy policies[] = {
+      S21NumaPolicy::kDefault, S21NumaPolicy::kFirstTouch,
+      S21NumaPolicy::kInterleave, S21NumaPolicy::kBindBlocks};
+  S21SetThreadCount(4);
+  for (S21NumaPolicy policy : policies) {
+    S21SetNumaPolicy(policy);
+    EXPECT_EQ(S21GetNumaPolicy(), policy);
+    // 600 x 600 double больше kNumaMinBytes
+    S21Matrix big(600, 600);
+    EXPECT_EQ(big(599, 599), 0.0);
+    for (int i = 0; i < 600; i++) {
+      big(i, (i * 7) % 600) = 1.0;
+    }
+    EXPECT_EQ(big.Sum(), 600.0);
+    S21Matrix copy(big);
+    copy.SetRows(700);
+    EXPECT_EQ(copy(699, 0), 0.0);
+    EXPECT_EQ(copy.Sum(), 600.0);
+    S21Matrix small(2, 2);
+    small(1, 1) = 3.0;
+    EXPECT_EQ(small.Trace(), 3.0);
+  }
+  S21SetNumaPolicy(S21NumaPolicy::kDefault);
+  S21SetThreadCount(0);
+}
+
+TEST(Numa, ThreadPinning) {
+  S21SetThreadPinning(true);
+  EXPECT_TRUE(S21GetThreadPinning());
+#ifdef __linux__
+  cpu_set_t before;
+  sched_getaffinity(0, sizeof(before), &before);
+  {
+    S21ThreadPin pin(1, 2);
+    cpu_set_t pinned;
+    sched_getaffinity(0, sizeof(pinned), &pinned);
+    EXPECT_EQ(CPU_COUNT(&pinned), 1);
+  }
+  cpu_set_t after;
+  sched_getaffinity(0, sizeof(after), &after);
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+#endif
+  S21SetThreadCount(3);
+  std::vector<int> seen(3, 0);
+  int parts = S21ParallelFor(0, 300, 1, [&](int part, int begin, int end) {
+    seen[part] = end - begin;
+  });
+  EXPECT_EQ(parts, 3);
+  EXPECT_EQ(seen[0] + seen[1] + seen[2], 300);
+  S21SetThreadPinning(false);
+  S21SetThreadCount(0);
+}
+
+TEST(Quantized, DequantizeError) {
+  S21Matrix A(5, 37);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 37; j++) {
+      A(i, j) = std::sin(i * 37 + j) * (i + 1);
+    }
+  }
+  for (S21Quantization mode :
+       {S21Quantization::kPerTensor, S21Quantization::kPerRow}) {
+    S21QuantizedMatrix Q(A, mode);
+    S21Matrix D = Q.Dequantize();
+    for (int i = 0; i < 5; i++) {
+      for (int j = 0; j < 37; j++) {
+        EXPECT_LE(std::fabs(D(i, j) - A(i, j)), Q.GetScale(i) / 2 + 1e-12);
+      }
+    }
+  }
+  S21QuantizedMatrix Z(S21Matrix(2, 2), S21Quantization::kPerRow);
+  EXPECT_EQ(Z.GetValue(1, 1), 0);
+  EXPECT_EQ(Z.GetZeroPoint(0), 0);
+  EXPECT_THROW(Z.GetValue(2, 0), std::out_of_range);
+}
+
+TEST(Quantized, KernelsAgree) {
+  S21Matrix A(23, 70), W(70, 41);
+  for (int i = 0; i < 23; i++) {
+    for (int j = 0; j < 70; j++) {
+      A(i, j) = std::cos(i * 3 + j * 0.7);
+    }
+  }
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 41; j++) {
+      W(i, j) = std::sin(i * 0.3 - j) * 0.5 + 0.1;
+    }
+  }
+  S21QuantizedMatrix QA(A, S21Quantization::kPerTensor);
+  S21QuantizedMatrix QW(W.Transpose(), S21Quantization::kPerRow);
+  S21QuantizedMatrix::SetKernel(S21Int8Kernel::kPortable);
+  S21QuantizedProduct expected = S21QuantizedMatrix::MulTransposed(QA, QW);
+  for (S21Int8Kernel kernel : {S21Int8Kernel::kAvx2, S21Int8Kernel::kVnni,
+                               S21Int8Kernel::kAuto}) {
+    S21QuantizedMatrix::SetKernel(kernel);
+    S21QuantizedProduct P = S21QuantizedMatrix::MulTransposed(QA, QW);
+    for (int i = 0; i < 23; i++) {
+      for (int j = 0; j < 41; j++) {
+        ASSERT_EQ(P.GetElement(i, j), expected.GetElement(i, j));
+      }
+    }
+  }
+  S21QuantizedMatrix::SetKernel(S21Int8Kernel::kAuto);
+  S21Matrix exact = A * W;
+  S21Matrix approx = expected.Dequantize();
+  for (int i = 0; i < 23; i++) {
+    for (int j = 0; j < 41; j++) {
+      EXPECT_NEAR(approx(i, j), exact(i, j), 0.15);
+    }
+  }
+  S21QuantizedMatrix QWrong(W, S21Quantization::kPerRow);
+  EXPECT_THROW(S21QuantizedMatrix::MulTransposed(QA, QWrong),
+               std::invalid_argument);
+}
+
+TEST(Quantized, WidestExactDepth) {
+  // Строка из единиц квантуется в 127 с нулевой точкой -128: каждое
+  // произведение равно 255 * 255, и 33025 из них еще помещаются в int32
+  const int depth = 33025;
+  S21Matrix ones(1, depth + 1);
+  for (int j = 0; j <= depth; j++) {
+    ones(0, j) = 1.0;
+  }
+  S21Matrix row = ones;
+  row.SetCols(depth);
+  S21QuantizedMatrix Q(row, S21Quantization::kPerRow);
+  ASSERT_EQ(Q.GetValue(0, 0) - Q.GetZeroPoint(0), 255);
+  for (S21Int8Kernel kernel : {S21Int8Kernel::kPortable, S21Int8Kernel::kAvx2,
+                               S21Int8Kernel::kVnni}) {
+    S21QuantizedMatrix::SetKernel(kernel);
+    S21QuantizedProduct P = S21QuantizedMatrix::MulTransposed(Q, Q);
+    EXPECT_EQ(P.GetElement(0, 0), 2147450625);
+  }
+  S21QuantizedMatrix::SetKernel(S21Int8Kernel::kAuto);
+  S21QuantizedMatrix wide(ones, S21Quantization::kPerRow);
+  EXPECT_THROW(S21QuantizedMatrix::MulTransposed(wide, wide),
+               std::invalid_argument);
+}
+
+TEST(Half, Encoding) {
+  S21Matrix A(1, 6);
+  A(0, 0) = 1;
+  A(0, 1) = -2;
+  A(0, 2) = 65504;
+  A(0, 3) = 65520;
+  A(0, 4) = std::ldexp(1.0, -24);
+  A(0, 5) = 1 + std::ldexp(1.0, -11);
+  S21HalfMatrix H(A, S21HalfFormat::kFloat16);
+  const uint16_t expected[] = {0x3C00, 0xC000, 0x7BFF, 0x7C00, 0x0001, 0x3C00};
+  for (int j = 0; j < 6; j++) {
+    EXPECT_EQ(H.Data()[j], expected[j]);
+  }
+  S21HalfMatrix B(A, S21HalfFormat::kBFloat16);
+  EXPECT_EQ(B.Data()[0], 0x3F80);
+  EXPECT_DOUBLE_EQ(B.GetElement(0, 2), 65536);
+  B.SetElement(0, 0, 3.0);
+  EXPECT_DOUBLE_EQ(B.ToMatrix()(0, 0), 3.0);
+  EXPECT_THROW(B.GetElement(1, 0), std::out_of_range);
+
+  // Все конечные fp16 переживают декодирование и обратное кодирование
+  std::vector<uint16_t> all(65536), back(65536);
+  std::vector<float> decoded(65536);
+  for (int k = 0; k < 65536; k++) {
+    all[k] = static_cast<uint16_t>(k);
+  }
+  S21HalfMatrix::Decode(all.data(), decoded.data(), all.size(),
+                        S21HalfFormat::kFloat16);
+  std::vector<double> wide(decoded.begin(), decoded.end());
+  S21HalfMatrix::Encode(wide.data(), back.data(), wide.size(),
+                        S21HalfFormat::kFloat16);
+  for (int k = 0; k < 65536; k++) {
+    if ((k & 0x7C00) != 0x7C00 || (k & 0x3FF) == 0) {
+      ASSERT_EQ(back[k], all[k]);
+    }
+  }
+}
+
+TEST(Half, Arithmetic) {
+  S21Matrix A(19, 150), B(150, 133);
+  for (int i = 0; i < 19; i++) {
+    for (int j = 0; j < 150; j++) {
+      A(i, j) = std::sin(i + j * 0.1);
+    }
+  }
+  for (int i = 0; i < 150; i++) {
+    for (int j = 0; j < 133; j++) {
+      B(i, j) = std::cos(i * 0.2 - j);
+    }
+  }
+  for (S21HalfFormat format :
+       {S21HalfFormat::kFloat16, S21HalfFormat::kBFloat16}) {
+    S21HalfMatrix HA(A, format), HB(B, format);
+    S21Matrix exact = HA.ToMatrix() * HB.ToMatrix();
+    S21Matrix in_float = HA.Mul(HB, S21HalfAccumulator::kFloat);
+    S21Matrix in_double = HA.Mul(HB, S21HalfAccumulator::kDouble);
+    EXPECT_TRUE(in_double.EqMatrix(exact));
+    for (int i = 0; i < 19; i++) {
+      for (int j = 0; j < 133; j++) {
+        EXPECT_NEAR(in_float(i, j), exact(i, j), 1e-4);
+      }
+    }
+    double tolerance = format == S21HalfFormat::kFloat16 ? 2e-3 : 2e-2;
+    S21Matrix sum = HA.Sum(HA.MulNumber(-0.5)).ToMatrix();
+    S21Matrix diff = HA.Sub(HA).ToMatrix();
+    for (int j = 0; j < 150; j++) {
+      EXPECT_NEAR(sum(3, j), A(3, j) / 2, tolerance);
+      EXPECT_EQ(diff(3, j), 0);
+    }
+    EXPECT_THROW(HA.Mul(HA, S21HalfAccumulator::kFloat),
+                 std::invalid_argument);
+    EXPECT_THROW(HA.Sum(HB), std::invalid_argument);
+  }
+}
+
+TEST(Krylov, OperatorConjugateGradient) {
+  // Уравнение Пуассона на сетке 40 x 40 без хранения матрицы
+  const int side = 40;
+  auto laplace = [side](const std::vector<double> &x, std::vector<double> &y) {
+    for (int i = 0; i < side; i++) {
+      for (int j = 0; j < side; j++) {
+        int k = i * side + j;
+        double value = 4 * x[k];
+        if (i > 0) value -= x[k - side];
+        if (i + 1 < side) value -= x[k + side];
+        if (j > 0) value -= x[k - 1];
+        if (j + 1 < side) value -= x[k + 1];
+        y[k] = value;
+      }
+    }
+  };
+  std::vector<double> b(side * side, 1.0);
+  S21KrylovOptions options;
+  options.tolerance = 1e-8;
+  S21KrylovResult cg = S21ConjugateGradient(laplace, b, options);
+  EXPECT_TRUE(cg.converged);
+  EXPECT_LE(cg.residual, 1e-8);
+  EXPECT_EQ(cg.history.size(), static_cast<size_t>(cg.iterations));
+  S21KrylovResult gmres = S21Gmres(laplace, b, options);
+  EXPECT_TRUE(gmres.converged);
+  for (size_t k = 0; k < b.size(); k++) {
+    EXPECT_NEAR(gmres.x[k], cg.x[k], 1e-5);
+  }
+  options.max_iterations = 3;
+  S21KrylovResult limited = S21ConjugateGradient(laplace, b, options);
+  EXPECT_FALSE(limited.converged);
+  EXPECT_EQ(limited.iterations, 3);
+  EXPECT_THROW(S21ConjugateGradient(laplace, {}), std::invalid_argument);
+}
+
+TEST(Krylov, MatrixPreconditioners) {
+  // Несимметричная трехдиагональная матрица конвекции-диффузии
+  const int n = 200;
+  S21Matrix A(n, n);
+  std::vector<double> expected(n), b(n);
+  for (int i = 0; i < n; i++) {
+    A(i, i) = 2.5 + 0.01 * i;
+    if (i > 0) A(i, i - 1) = -1.4;
+    if (i + 1 < n) A(i, i + 1) = -0.6;
+    expected[i] = std::sin(0.1 * i);
+  }
+  S21LinearOperator op = S21MatrixOperator(A);
+  op(expected, b);
+  S21JacobiPreconditioner jacobi(A);
+  S21Ilu0Preconditioner ilu(A);
+  S21KrylovResult plain = S21BiCgStab(op, b);
+  S21KrylovResult with_jacobi = S21BiCgStab(op, b, {}, jacobi);
+  S21KrylovResult with_ilu = S21Gmres(op, b, {}, ilu);
+  for (const S21KrylovResult &result : {plain, with_jacobi, with_ilu}) {
+    EXPECT_TRUE(result.converged);
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(result.x[i], expected[i], 1e-7);
+    }
+  }
+  // Для трехдиагональной матрицы ILU(0) совпадает с точным LU
+  EXPECT_EQ(with_ilu.iterations, 1);
+  S21Matrix singular(2, 2);
+  EXPECT_THROW(S21JacobiPreconditioner{singular}, std::logic_error);
+  EXPECT_THROW(S21Ilu0Preconditioner{S21Matrix(2, 3)}, std::logic_error);
+}
+
+TEST(LowRank, RecoversSpectrum) {
+  // A = U * diag(s) * V^T с известными сингулярными числами 2^-j
+  const int m = 300, n = 120;
+  S21Matrix gu(m, n), gv(n, n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      gu(i, j) = std::sin(i * 1.3 + j * j * 0.7 + 0.1 * i * j);
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      gv(i, j) = std::cos(i * 0.9 + j * j * 1.1 + 0.05 * i * j);
+    }
+  }
+  S21Matrix u, v, r;
+  gu.QRDecomposition(u, r);
+  gv.QRDecomposition(v, r);
+  S21Matrix scaled = u;
+  for (int j = 0; j < n; j++) {
+    for (int i = 0; i < m; i++) {
+      scaled(i, j) *= std::ldexp(1.0, -j);
+    }
+  }
+  S21Matrix A = scaled * v.Transpose();
+
+  S21LowRank approx = S21RandomizedSvd(A, 6);
+  EXPECT_EQ(approx.passes, 6);
+  for (int j = 0; j < 6; j++) {
+    EXPECT_NEAR(approx.singular_values(j, 0), std::ldexp(1.0, -j), 1e-10);
+  }
+  // Остаток - числа 2^-6, 2^-7, ...: ошибка sqrt(sum 4^-j)
+  double expected = std::sqrt(std::ldexp(1.0, -12) * 4.0 / 3.0);
+  EXPECT_NEAR(approx.error, expected, 1e-6);
+  S21Matrix gram = approx.u.Transpose() * approx.u;
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      EXPECT_NEAR(gram(i, j), i == j ? 1.0 : 0.0, 1e-12);
+    }
+  }
+  S21Matrix diag(6, 6);
+  for (int j = 0; j < 6; j++) {
+    diag(j, j) = approx.singular_values(j, 0);
+  }
+  S21Matrix rest = A - approx.u * diag * approx.v.Transpose();
+  EXPECT_NEAR(rest.NormFrobenius(), approx.error, 1e-6);
+  EXPECT_THROW(S21RandomizedSvd(A, 0), std::invalid_argument);
+  EXPECT_THROW(S21RandomizedSvd(A, n + 1), std::invalid_argument);
+}
+
+TEST(LowRank, StreamedPanels) {
+  const int m = 157, n = 40;
+  S21Matrix A(m, n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      A(i, j) = 1.0 / (i + j + 1);
+    }
+  }
+  int reads = 0;
+  int max_panel = 0;
+  auto reader = [&](int first, S21Matrix &panel) {
+    reads++;
+    max_panel = std::max(max_panel, panel.GetRows());
+    for (int i = 0; i < panel.GetRows(); i++) {
+      for (int j = 0; j < n; j++) {
+        panel(i, j) = A(first + i, j);
+      }
+    }
+  };
+  S21LowRankOptions options;
+  options.panel_rows = 32;
+  options.power_iterations = 1;
+  S21LowRank streamed = S21RandomizedSvd(m, n, reader, 6, options);
+  S21LowRank in_memory = S21RandomizedSvd(A, 6, options);
+  EXPECT_EQ(streamed.passes, 4);
+  EXPECT_EQ(reads, 4 * 5);
+  EXPECT_EQ(max_panel, 32);
+  for (int j = 0; j < 6; j++) {
+    EXPECT_NEAR(streamed.singular_values(j, 0),
+                in_memory.singular_values(j, 0), 1e-12);
+    EXPECT_NEAR(std::abs(streamed.v(0, j)), std::abs(in_memory.v(0, j)),
+                1e-9);
+  }
+  // Матрица Гильберта: сингулярные числа убывают очень быстро
+  EXPECT_LT(streamed.error, 1e-3 * A.NormFrobenius());
+}
+
+TEST(SharedMemory, PublishAndAttach) {
+  std::string name = "/s21_test_" + std::to_string(getpid());
+  S21SharedMatrix::Unlink(name);
+  S21Matrix A(30, 17);
+  for (int i = 0; i < 30; i++) {
+    for (int j = 0; j < 17; j++) {
+      A(i, j) = i * 0.5 - j;
+    }
+  }
+  S21SharedMatrix published = S21SharedMatrix::Publish(name, A);
+  EXPECT_THROW(S21SharedMatrix::Create(name, 2, 2), std::runtime_error);
+  pid_t child = fork();
+  if (child == 0) {
+    // Другой процесс видит те же данные
+    bool ok = false;
+    try {
+      S21SharedMatrix view = S21SharedMatrix::Attach(name, 1000);
+      ok = view.ToMatrix().EqMatrix(A) && view.GetVersion() == 2;
+    } catch (...) {
+    }
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  waitpid(child, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  S21SharedMatrix view = S21SharedMatrix::Attach(name);
+  EXPECT_FALSE(view.IsWritable());
+  EXPECT_THROW(view.MutableData(), std::logic_error);
+  EXPECT_THROW(view(30, 0), std::out_of_range);
+  published.BeginUpdate();
+  EXPECT_FALSE(view.IsReady());
+  EXPECT_EQ(view.GetVersion(), 3u);
+  EXPECT_FALSE(view.IsConsistent(3));
+  published.MutableData()[0] = 42;
+  published.MarkReady();
+  EXPECT_EQ(view(0, 0), 42);
+  EXPECT_EQ(view.GetVersion(), 4u);
+  EXPECT_FALSE(view.IsConsistent(2));
+  S21SharedMatrix::Unlink(name);
+  EXPECT_EQ(view(29, 16), A(29, 16));
+  EXPECT_THROW(S21SharedMatrix::Attach(name), std::runtime_error);
+}
+
+TEST(SharedMemory, AttachWaitsForReady) {
+  std::string name = "s21_wait_" + std::to_string(getpid());
+  S21SharedMatrix::Unlink(name);
+  std::thread writer([&name] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    S21SharedMatrix shared = S21SharedMatrix::Create(name, 4, 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    for (int k = 0; k < 16; k++) {
+      shared.MutableData()[k] = k;
+    }
+    shared.MarkReady();
+  });
+  S21SharedMatrix view = S21SharedMatrix::Attach(name, 5000);
+  writer.join();
+  EXPECT_EQ(view.GetName(), "/" + name);
+  EXPECT_EQ(view(3, 3), 15);
+  S21SharedMatrix moved = std::move(view);
+  EXPECT_EQ(moved.ToMatrix()(2, 1), 9);
+  S21SharedMatrix::Unlink(name);
+}
+
+TEST(SharedMemory, ReaderNeverAcceptsTornData) {
+  std::string name = "s21_seqlock_" + std::to_string(getpid());
+  S21SharedMatrix::Unlink(name);
+  const int size = 64 * 64;
+  const int updates = 2000;
+  S21SharedMatrix shared = S21SharedMatrix::Create(name, 64, 64);
+  shared.MarkReady();
+  S21SharedMatrix view = S21SharedMatrix::Attach(name);
+  // Писатель каждый раз заполняет всю матрицу одним числом
+  std::thread writer([&shared, size, updates] {
+    for (int k = 1; k <= updates; k++) {
+      shared.BeginUpdate();
+      for (int e = 0; e < size; e++) {
+        shared.MutableData()[e] = k;
+      }
+      shared.MarkReady();
+    }
+  });
+  std::vector<double> copy(size);
+  int torn = 0;
+  int accepted = 0;
+  // Последняя версия 2 + 2 * updates; после нее хотя бы одно чтение
+  // проходит проверку
+  while (accepted == 0 || view.GetVersion() < 2u * updates + 2) {
+    uint64_t version = view.GetVersion();
+    std::copy(view.Data(), view.Data() + size, copy.begin());
+    if (!view.IsConsistent(version)) {
+      continue;
+    }
+    accepted++;
+    for (int e = 1; e < size; e++) {
+      torn += copy[e] != copy[0];
+    }
+  }
+  writer.join();
+  EXPECT_EQ(torn, 0);
+  S21Matrix last = view.ToMatrix();
+  EXPECT_EQ(last(63, 63), updates);
+  S21SharedMatrix::Unlink(name);
+}
+
+TEST(Semiring, ShortestPathsAndReachability) {
+  // Ориентированный граф из 70 вершин: больше одного блока умножения
+  const int n = 70;
+  const double inf = std::numeric_limits<double>::infinity();
+  S21Matrix weights(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      bool edge = (i * 7 + j * 13) % 11 == 0 && i != j;
+      weights(i, j) = edge ? 1 + (i * j) % 9 : inf;
+    }
+  }
+  S21SemiringMatrix<S21MinPlus> graph(weights);
+  S21Matrix paths = graph.Closure().ToMatrix();
+  // Флойд-Уоршелл
+  S21Matrix expected = weights;
+  for (int i = 0; i < n; i++) {
+    expected(i, i) = 0;
+  }
+  for (int k = 0; k < n; k++) {
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        expected(i, j) =
+            std::min(expected(i, j), expected(i, k) + expected(k, j));
+      }
+    }
+  }
+  S21SemiringMatrix<S21Boolean> reach =
+      S21SemiringMatrix<S21Boolean>(weights.Map([inf](double w) {
+        return w == inf ? 0.0 : 1.0;
+      })).Closure();
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      ASSERT_EQ(paths(i, j), expected(i, j));
+      ASSERT_EQ(reach(i, j), expected(i, j) != inf);
+    }
+  }
+  // Степень k - пути не длиннее k ребер
+  S21SemiringMatrix<S21MinPlus> two = graph.Power(2);
+  EXPECT_TRUE(two == graph * graph);
+  EXPECT_TRUE(graph.Power(0) == S21SemiringMatrix<S21MinPlus>::Identity(n));
+  EXPECT_THROW(graph.Power(-1), std::invalid_argument);
+  EXPECT_THROW(S21SemiringMatrix<S21MinPlus>(2, 3).Closure(), std::logic_error);
+
+  S21SemiringMatrix<S21MaxPlus> dag(3, 3);
+  dag(0, 1) = 2;
+  dag(1, 2) = 3;
+  dag(0, 2) = 4;
+  EXPECT_EQ(dag.Closure()(0, 2), 5);
+}
+
+TEST(Semiring, ModularPower) {
+  S21ModP mod;
+  S21SemiringMatrix<S21ModP> fib(2, 2, mod);
+  fib(0, 0) = fib(0, 1) = fib(1, 0) = 1;
+  uint64_t a = 0, b = 1;
+  for (int k = 0; k < 1000; k++) {
+    uint64_t next = (a + b) % mod.GetModulus();
+    a = b;
+    b = next;
+  }
+  EXPECT_EQ(fib.Power(1000)(0, 1), a);
+
+  // Модуль больше 2^63: сумма переполняет 64 бита
+  const uint64_t big = 18446744073709551557ull;
+  S21ModP wide(big);
+  EXPECT_EQ(wide.Add(big - 1, big - 2), big - 3);
+  EXPECT_EQ(wide.Mul(big - 1, big - 1), 1u);
+  S21SemiringMatrix<S21ModP> m(S21Matrix(2, 2), wide);
+  m(0, 0) = big - 1;
+  m(1, 1) = 2;
+  S21SemiringMatrix<S21ModP> cube = m.Power(3);
+  EXPECT_EQ(cube(0, 0), big - 1);
+  EXPECT_EQ(cube(1, 1), 8u);
+  EXPECT_EQ(wide.FromDouble(-1), big - 1);
+  // Модуль больше 2^53 не представим в double точно
+  const uint64_t mersenne = (uint64_t{1} << 61) - 1;
+  S21ModP exact(mersenne);
+  EXPECT_EQ(exact.FromDouble(std::ldexp(1.0, 61)), 1u);
+  EXPECT_EQ(exact.FromDouble(std::ldexp(1.0, 62)), 2u);
+  EXPECT_EQ(exact.FromDouble(-std::ldexp(3.0, 200)),
+            mersenne - exact.Mul(3, uint64_t{1} << (200 % 61)));
+  EXPECT_EQ(wide.FromDouble(std::ldexp(1.0, 64)), 59u);
+  EXPECT_THROW(exact.FromDouble(std::nan("")), std::invalid_argument);
+  EXPECT_THROW(S21ModP(1), std::invalid_argument);
+  // Closure для вычетов не компилируется: (I + A)^(2^s) не сумма степеней
+  static_assert(!S21ModP::kIdempotent, "Residues are not idempotent");
+}
+
+TEST(BitMatrix, ConversionsAndLogic) {
+  S21Matrix A(5, 70), B(5, 70);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 70; j++) {
+      A(i, j) = (i + j) % 3 == 0 ? 2.5 : 0;
+      B(i, j) = (i * j) % 2;
+    }
+  }
+  S21BitMatrix a(A), b(B);
+  EXPECT_TRUE(a.ToMatrix().EqMatrix(A.Map([](double x) { return x != 0; })));
+  EXPECT_TRUE(a.Get(0, 69));
+  EXPECT_FALSE(a.Get(0, 68));
+  long long ones = a.Count();
+  // Инверсия не трогает биты за последним столбцом
+  EXPECT_EQ((~a).Count(), 5 * 70 - ones);
+  EXPECT_TRUE(~~a == a);
+  S21BitMatrix both = a & b, either = a | b, diff = a ^ b;
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 70; j++) {
+      EXPECT_EQ(both.Get(i, j), a.Get(i, j) && b.Get(i, j));
+      EXPECT_EQ(either.Get(i, j), a.Get(i, j) || b.Get(i, j));
+      EXPECT_EQ(diff.Get(i, j), a.Get(i, j) != b.Get(i, j));
+    }
+  }
+  a.Set(4, 3, true);
+  EXPECT_TRUE(a.Get(4, 3));
+  a.Set(4, 3, false);
+  EXPECT_FALSE(a.Get(4, 3));
+  EXPECT_THROW(a.Get(5, 0), std::out_of_range);
+  EXPECT_THROW(a & S21BitMatrix(5, 71), std::invalid_argument);
+}
+
+TEST(BitMatrix, TransposeAndProducts) {
+  const int m = 130, k = 97, n = 75;
+  S21Matrix A(m, k), B(k, n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < k; j++) {
+      A(i, j) = (i * 31 + j * 17) % 7 < 2;
+    }
+  }
+  for (int i = 0; i < k; i++) {
+    for (int j = 0; j < n; j++) {
+      B(i, j) = (i * 5 + j * 11) % 13 < 3;
+    }
+  }
+  S21BitMatrix a(A), b(B);
+  S21BitMatrix t = a.Transpose();
+  EXPECT_EQ(t.GetRows(), k);
+  EXPECT_TRUE(t.ToMatrix().EqMatrix(A.Transpose()));
+  EXPECT_TRUE(t.Transpose() == a);
+  // Счетное произведение совпадает с обычным для матриц из 0 и 1
+  S21Matrix counts = a.CountMul(b);
+  EXPECT_TRUE(counts.EqMatrix(A * B));
+  S21BitMatrix reach = a.Mul(b);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      ASSERT_EQ(reach.Get(i, j), counts(i, j) > 0);
+    }
+  }
+  EXPECT_THROW(a.Mul(a), std::invalid_argument);
+}
+
+TEST(Gemm, TransposeFlagsAndAccumulation) {
+  const int m = 70, k = 90, n = 65;
+  S21Matrix A(m, k), B(k, n), C0(m, n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < k; j++) {
+      A(i, j) = std::sin(i * 0.3 + j * 0.7);
+    }
+    for (int j = 0; j < n; j++) {
+      C0(i, j) = std::cos(i * 0.5 - j * 0.2);
+    }
+  }
+  for (int i = 0; i < k; i++) {
+    for (int j = 0; j < n; j++) {
+      B(i, j) = std::cos(i * 0.1 + j * 0.9);
+    }
+  }
+  S21Matrix At = A.Transpose(), Bt = B.Transpose();
+  S21Matrix expected = A * B * 2.0 + C0 * 0.5;
+  const S21Op ops[] = {S21Op::kNoTrans, S21Op::kTrans};
+  for (S21Op op_a : ops) {
+    for (S21Op op_b : ops) {
+      S21Matrix C(C0);
+      C.Gemm(op_a, op_b, 2.0, op_a == S21Op::kTrans ? At : A,
+             op_b == S21Op::kTrans ? Bt : B, 0.5);
+      for (int i = 0; i < m; i++) {
+        for (int j = 0; j < n; j++) {
+          ASSERT_NEAR(C(i, j), expected(i, j), 1e-10);
+        }
+      }
+    }
+  }
+  // При beta == 0 прежнее содержимое не читается, даже NaN
+  S21Matrix D(m, n);
+  D(3, 4) = std::nan("");
+  D.Gemm(S21Op::kTrans, S21Op::kNoTrans, 1.0, At, B, 0.0);
+  S21Matrix product = A * B;
+  EXPECT_NEAR(D(3, 4), product(3, 4), 1e-10);
+  // this может быть множителем: S = S^T * S
+  S21Matrix S(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      S(i, j) = i * 3 + j + 1;
+    }
+  }
+  S21Matrix gram = S.Transpose() * S;
+  S.Gemm(S21Op::kTrans, S21Op::kNoTrans, 1.0, S, S, 0.0);
+  EXPECT_TRUE(S.EqMatrix(gram));
+  EXPECT_THROW(C0.Gemm(S21Op::kNoTrans, S21Op::kNoTrans, 1.0, A, Bt, 0.0),
+               std::invalid_argument);
+  EXPECT_THROW(C0.Gemm(S21Op::kNoTrans, S21Op::kNoTrans, 1.0, A, B,
+                       std::nan("")),
+               std::invalid_argument);
+}
+
+TEST(Gemm, SyrkStreamedGram) {
+  const int rows = 150, cols = 70, block = 40;
+  S21Matrix A(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      A(i, j) = std::sin(i * 0.13 + j * 0.37) + (i == j);
+    }
+  }
+  S21Matrix gram = A.Transpose() * A;
+  S21Matrix G(cols, cols);
+  G.Syrk(S21Op::kTrans, 1.0, A, 0.0);
+  // Та же матрица Грама, накопленная по блокам строк
+  S21Matrix streamed(cols, cols);
+  for (int begin = 0; begin < rows; begin += block) {
+    int count = std::min(block, rows - begin);
+    S21Matrix panel(count, cols);
+    for (int i = 0; i < count; i++) {
+      for (int j = 0; j < cols; j++) {
+        panel(i, j) = A(begin + i, j);
+      }
+    }
+    streamed.Syrk(S21Op::kTrans, 1.0, panel, 1.0, false);
+  }
+  EXPECT_EQ(streamed(0, cols - 1), 0.0);
+  streamed.MirrorLower();
+  for (int i = 0; i < cols; i++) {
+    for (int j = 0; j < cols; j++) {
+      ASSERT_NEAR(G(i, j), gram(i, j), 1e-10);
+      ASSERT_NEAR(streamed(i, j), gram(i, j), 1e-10);
+    }
+  }
+  S21Matrix outer = A * A.Transpose();
+  S21Matrix H(rows, rows);
+  H.Syrk(S21Op::kNoTrans, 0.5, A, 0.0);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < rows; j++) {
+      ASSERT_NEAR(H(i, j), 0.5 * outer(i, j), 1e-10);
+    }
+  }
+  EXPECT_THROW(H.Syrk(S21Op::kTrans, 1.0, A, 0.0), std::invalid_argument);
+  EXPECT_THROW(A.MirrorLower(), std::logic_error);
+}
+
+TEST(Gemm, SyrkTallPartialBlocks) {
+  // Ни число строк, ни число столбцов не кратно блоку 64: крайние блоки
+  // треугольника и панели строк неполные
+  const int rows = 333, cols = 130;
+  S21Matrix A(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      A(i, j) = std::cos(i * 0.11 - j * 0.29) + 0.01 * (i % 7);
+    }
+  }
+  S21Matrix At = A.Transpose();
+  S21Matrix C0(cols, cols);
+  for (int i = 0; i < cols; i++) {
+    for (int j = 0; j < cols; j++) {
+      C0(i, j) = std::sin(i * 0.4 + j * 0.4);
+    }
+  }
+  S21Matrix expected = At * A * 1.5 + C0 * 2.0;
+  S21Matrix G(C0);
+  G.Syrk(S21Op::kTrans, 1.5, A, 2.0);
+  S21Matrix T(C0);
+  T.Gemm(S21Op::kTrans, S21Op::kTrans, 1.5, A, At, 2.0);
+  for (int i = 0; i < cols; i++) {
+    for (int j = 0; j < cols; j++) {
+      ASSERT_NEAR(G(i, j), expected(i, j), 1e-9);
+      ASSERT_NEAR(T(i, j), expected(i, j), 1e-9);
+    }
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();